@@ -1,130 +1,286 @@
 #include "Account.h"
 #include "Transaction.h"
+#include "TransactionJournal.h"
+#include "TransactionArchive.h"
+#include "LedgerStatistics.h"
+#include "Customer.h"
+#include "PeriodClock.h"
+#include "IdGenerator.h"
+#include "MetricsRegistry.h"
+#include "MemoryAccounting.h"
+#include "Tracer.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
-#include <ctime>
-#include <random>
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 
-Account::Account() : balance(0.0), interestRate(0.0), accountActive(true), 
-                     minimumBalance(0.0), dailyWithdrawalLimit(1000.0), 
-                     monthlyWithdrawalLimit(5000.0), dailyWithdrawn(0.0), 
-                     monthlyWithdrawn(0.0) {
+namespace {
+
+// Withdrawal windows: period number in the high bits, withdrawn cents below
+const int kWindowPeriodShift = 44;
+const long long kWindowAmountMask = (1LL << kWindowPeriodShift) - 1;
+
+long long packWindow(long long period, long long cents) {
+    return (period << kWindowPeriodShift) | (cents & kWindowAmountMask);
+}
+
+long long windowPeriod(long long window) {
+    return window >> kWindowPeriodShift;
+}
+
+long long windowAmount(long long window) {
+    return window & kWindowAmountMask;
+}
+
+// Published by the rollover scheduler, so the hot path never touches the calendar
+long long currentDayNumber() {
+    return PeriodClock::shared().getDayNumber();
+}
+
+long long currentMonthNumber() {
+    return PeriodClock::shared().getMonthNumber();
+}
+
+bool reserveWindow(std::atomic<long long>& window, long long period, long long cents, long long limitCents) {
+    long long current = window.load(std::memory_order_relaxed);
+    while (true) {
+        long long used = windowPeriod(current) == period ? windowAmount(current) : 0;
+        if (used + cents > limitCents) {
+            return false;
+        }
+        if (window.compare_exchange_weak(current, packWindow(period, used + cents),
+                                         std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void releaseWindow(std::atomic<long long>& window, long long period, long long cents) {
+    long long current = window.load(std::memory_order_relaxed);
+    while (windowPeriod(current) == period) {
+        long long used = windowAmount(current);
+        long long restored = used > cents ? used - cents : 0;
+        if (window.compare_exchange_weak(current, packWindow(period, restored),
+                                         std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+} // namespace
+
+Account::Account() : balanceCents(0), interestRate(0.0), accountActive(true), 
+                     transactionHead(nullptr), transactionCount(0),
+                     minimumBalance(), dailyWithdrawalLimit(Money::fromCents(100000)), 
+                     monthlyWithdrawalLimit(Money::fromCents(500000)), dailyWindow(0), monthlyWindow(0),
+                     journal(nullptr), statistics(nullptr), owner(nullptr), archive(nullptr), archivedCount(0),
+                     archiveMaterialized(false) {
     generateAccountNumber();
     dateCreated = getCurrentDateTime();
-    lastTransactionDate = getCurrentDateTime();
 }
 
 Account::Account(const std::string& customerId, const std::string& accountType, double initialBalance)
-    : customerId(customerId), accountType(accountType), balance(initialBalance), 
-      interestRate(0.0), accountActive(true), minimumBalance(0.0), 
-      dailyWithdrawalLimit(1000.0), monthlyWithdrawalLimit(5000.0), 
-      dailyWithdrawn(0.0), monthlyWithdrawn(0.0) {
+    : accountType(accountType), balanceCents(toCents(initialBalance)), 
+      interestRate(0.0), accountActive(true), customerId(customerId), 
+      transactionHead(nullptr), transactionCount(0), minimumBalance(), 
+      dailyWithdrawalLimit(Money::fromCents(100000)), monthlyWithdrawalLimit(Money::fromCents(500000)), 
+      dailyWindow(0), monthlyWindow(0), journal(nullptr), statistics(nullptr), owner(nullptr), archive(nullptr),
+      archivedCount(0), archiveMaterialized(false) {
     generateAccountNumber();
     dateCreated = getCurrentDateTime();
-    lastTransactionDate = getCurrentDateTime();
 }
 
-Account::~Account() {}
+Account::~Account() {
+    TransactionNode* node = transactionHead.load();
+    while (node) {
+        TransactionNode* next = node->next;
+        delete node;
+        node = next;
+    }
+}
 
 // Getters
 std::string Account::getAccountNumber() const { return accountNumber; }
 std::string Account::getAccountType() const { return accountType; }
-double Account::getBalance() const { return balance; }
+double Account::getBalance() const { return fromCents(getBalanceCents()); }
+long long Account::getBalanceCents() const { return balanceCents.load(std::memory_order_acquire); }
+Money Account::getBalanceMoney() const { return Money::fromCents(getBalanceCents()); }
 double Account::getInterestRate() const { return interestRate; }
 bool Account::isActive() const { return accountActive; }
 std::string Account::getDateCreated() const { return dateCreated; }
 std::string Account::getCustomerId() const { return customerId; }
-double Account::getMinimumBalance() const { return minimumBalance; }
-double Account::getDailyWithdrawalLimit() const { return dailyWithdrawalLimit; }
-double Account::getMonthlyWithdrawalLimit() const { return monthlyWithdrawalLimit; }
+double Account::getMinimumBalance() const { return minimumBalance.toDouble(); }
+Money Account::getMinimumBalanceMoney() const { return minimumBalance; }
+double Account::getDailyWithdrawalLimit() const { return dailyWithdrawalLimit.toDouble(); }
+double Account::getMonthlyWithdrawalLimit() const { return monthlyWithdrawalLimit.toDouble(); }
+double Account::getDailyWithdrawn() const { return getDailyWithdrawnMoney().toDouble(); }
+double Account::getMonthlyWithdrawn() const { return getMonthlyWithdrawnMoney().toDouble(); }
+
+Money Account::getDailyWithdrawnMoney() const {
+    long long window = dailyWindow.load(std::memory_order_acquire);
+    return Money::fromCents(windowPeriod(window) == currentDayNumber() ? windowAmount(window) : 0);
+}
+
+Money Account::getMonthlyWithdrawnMoney() const {
+    long long window = monthlyWindow.load(std::memory_order_acquire);
+    return Money::fromCents(windowPeriod(window) == currentMonthNumber() ? windowAmount(window) : 0);
+}
+
+size_t Account::getTransactionCount() const { return archivedCount + transactionCount.load(std::memory_order_acquire); }
 
 // Setters
 void Account::setAccountNumber(const std::string& number) { accountNumber = number; }
 void Account::setAccountType(const std::string& type) { accountType = type; }
-void Account::setBalance(double amount) { balance = amount; }
+void Account::setBalance(double amount) { storeBalance(toCents(amount)); }
 void Account::setInterestRate(double rate) { interestRate = rate; }
 void Account::setActive(bool active) { accountActive = active; }
 void Account::setDateCreated(const std::string& date) { dateCreated = date; }
 void Account::setCustomerId(const std::string& id) { customerId = id; }
-void Account::setMinimumBalance(double amount) { minimumBalance = amount; }
-void Account::setDailyWithdrawalLimit(double limit) { dailyWithdrawalLimit = limit; }
-void Account::setMonthlyWithdrawalLimit(double limit) { monthlyWithdrawalLimit = limit; }
+void Account::setMinimumBalance(Money amount) { minimumBalance = amount; }
+void Account::setDailyWithdrawalLimit(Money limit) { dailyWithdrawalLimit = limit; }
+void Account::setMonthlyWithdrawalLimit(Money limit) { monthlyWithdrawalLimit = limit; }
+void Account::setJournal(TransactionJournal* journal) { this->journal = journal; }
+
+void Account::setStatistics(LedgerStatistics* statistics) {
+    if (this->statistics == statistics) {
+        return;
+    }
+    long long balance = getBalanceCents();
+    if (this->statistics) {
+        this->statistics->addBalance(-balance);
+    }
+    if (statistics) {
+        statistics->addBalance(balance);
+    }
+    this->statistics = statistics;
+}
+
+void Account::setOwner(Customer* owner) {
+    if (this->owner == owner) {
+        return;
+    }
+    long long balance = getBalanceCents();
+    if (this->owner) {
+        this->owner->adjustTotalBalance(-balance);
+    }
+    if (owner) {
+        owner->adjustTotalBalance(balance);
+    }
+    this->owner = owner;
+}
+
+Customer* Account::getOwner() const { return owner; }
+
+void Account::setArchive(const TransactionArchive* archive) {
+    this->archive = archive;
+    archivedCount = archive ? archive->countFor(accountNumber) : 0;
+}
 
 // Transaction methods
-bool Account::deposit(double amount) {
-    if (amount <= 0 || !accountActive) {
+bool Account::deposit(Money amount) {
+    if (amount <= Money() || !accountActive) {
         return false;
     }
     
-    balance += amount;
-    updateLimits();
-    
-    // Create transaction record
-    auto transaction = std::make_shared<Transaction>(
-        accountNumber, "Deposit", amount, balance, getCurrentDateTime()
-    );
-    addTransaction(transaction);
+    long long cents = amount.getCents();
+    long long newBalance = credit(cents);
+    recordTransaction("Deposit", cents, newBalance);
+    BankMetrics::shared().deposits.add();
     
     return true;
 }
 
-bool Account::withdraw(double amount) {
-    if (!canWithdraw(amount)) {
+bool Account::withdraw(Money amount) {
+    if (amount <= Money() || !accountActive) {
         return false;
     }
     
-    balance -= amount;
-    dailyWithdrawn += amount;
-    monthlyWithdrawn += amount;
-    updateLimits();
-    
-    // Create transaction record
-    auto transaction = std::make_shared<Transaction>(
-        accountNumber, "Withdrawal", -amount, balance, getCurrentDateTime()
-    );
-    addTransaction(transaction);
+    long long cents = amount.getCents();
+    long long newBalance;
+    if (!debit(cents, newBalance)) {
+        return false;
+    }
+    recordTransaction("Withdrawal", -cents, newBalance);
+    BankMetrics::shared().withdrawals.add();
     
     return true;
 }
 
-bool Account::transfer(Account& targetAccount, double amount) {
-    if (!canTransfer(amount) || !targetAccount.isActive()) {
+bool Account::transfer(Account& targetAccount, Money amount) {
+    if (amount <= Money() || !accountActive || !targetAccount.isActive()) {
         return false;
     }
     
-    // Withdraw from this account
-    balance -= amount;
-    dailyWithdrawn += amount;
-    monthlyWithdrawn += amount;
-    
-    // Deposit to target account
-    targetAccount.balance += amount;
-    
-    updateLimits();
-    targetAccount.updateLimits();
-    
-    // Create transaction records
-    auto transaction1 = std::make_shared<Transaction>(
-        accountNumber, "Transfer Out", -amount, balance, getCurrentDateTime()
-    );
-    auto transaction2 = std::make_shared<Transaction>(
-        targetAccount.getAccountNumber(), "Transfer In", amount, targetAccount.getBalance(), getCurrentDateTime()
-    );
+    long long cents = amount.getCents();
+    long long sourceBalance;
+    if (!debit(cents, sourceBalance)) {
+        return false;
+    }
+    long long targetBalance = targetAccount.credit(cents);
     
-    addTransaction(transaction1);
-    targetAccount.addTransaction(transaction2);
+    recordTransaction("Transfer Out", -cents, sourceBalance);
+    targetAccount.recordTransaction("Transfer In", cents, targetBalance);
+    BankMetrics::shared().transfers.add();
     
     return true;
 }
 
+// Adapters for callers still holding doubles; amounts round to the nearest cent
+bool Account::deposit(double amount) {
+    return deposit(Money::fromDouble(amount));
+}
+
+bool Account::withdraw(double amount) {
+    return withdraw(Money::fromDouble(amount));
+}
+
+bool Account::transfer(Account& targetAccount, double amount) {
+    return transfer(targetAccount, Money::fromDouble(amount));
+}
+
 void Account::addTransaction(std::shared_ptr<Transaction> transaction) {
-    transactions.push_back(transaction);
+    TransactionNode* node = new TransactionNode{std::move(transaction), transactionHead.load(std::memory_order_relaxed)};
+    while (!transactionHead.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+    }
+    transactionCount.fetch_add(1, std::memory_order_release);
 }
 
 std::vector<std::shared_ptr<Transaction>> Account::getTransactions() const {
-    return transactions;
+    std::vector<std::shared_ptr<Transaction>> history;
+    history.reserve(getTransactionCount());
+    for (TransactionNode* node = transactionHead.load(std::memory_order_acquire); node; node = node->next) {
+        history.push_back(node->transaction);
+    }
+    const auto& archived = getArchivedTransactions();
+    history.insert(history.end(), archived.rbegin(), archived.rend());
+    std::reverse(history.begin(), history.end());
+    return history;
+}
+
+const std::vector<std::shared_ptr<Transaction>>& Account::getArchivedTransactions() const {
+    std::call_once(archiveLoaded, [this]() {
+        if (archive && archivedCount > 0) {
+            TraceSpan span("loadHistory", "persistence");
+            archivedTransactions = archive->readAccount(accountNumber);
+        }
+        archiveMaterialized.store(true, std::memory_order_release);
+    });
+    return archivedTransactions;
+}
+
+void Account::forEachArchivedTransaction(const std::function<bool(const Transaction&)>& visit) const {
+    if (archiveMaterialized.load(std::memory_order_acquire)) {
+        for (auto it = archivedTransactions.rbegin(); it != archivedTransactions.rend(); ++it) {
+            if (!visit(**it)) {
+                return;
+            }
+        }
+    } else if (archive && archivedCount > 0) {
+        archive->visitAccount(accountNumber, visit);
+    }
 }
 
 void Account::displayTransactionHistory() const {
@@ -132,8 +288,9 @@ void Account::displayTransactionHistory() const {
     std::cout << "                TRANSACTION HISTORY\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
     std::cout << "Account: " << accountNumber << " (" << accountType << ")\n";
-    std::cout << "Current Balance: $" << std::fixed << std::setprecision(2) << balance << "\n\n";
+    std::cout << "Current Balance: $" << getBalanceMoney() << "\n\n";
     
+    auto transactions = getTransactions();
     if (transactions.empty()) {
         std::cout << "No transactions found.\n";
     } else {
@@ -144,8 +301,8 @@ void Account::displayTransactionHistory() const {
         for (const auto& transaction : transactions) {
             std::cout << std::setw(20) << transaction->getDate()
                       << std::setw(15) << transaction->getType()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << transaction->getAmount()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << transaction->getBalance() << "\n";
+                      << std::setw(15) << "$" << transaction->getAmountMoney()
+                      << std::setw(15) << "$" << transaction->getBalanceMoney() << "\n";
         }
     }
     
@@ -153,38 +310,50 @@ void Account::displayTransactionHistory() const {
 }
 
 // Interest calculation
-double Account::calculateInterest() const {
-    return balance * interestRate / 100.0;
+Money Account::calculateInterest() const {
+    return getBalanceMoney().interest(interestRate, getInterestPeriodsPerYear());
 }
 
 void Account::applyInterest() {
-    double interest = calculateInterest();
+    long long interest = calculateInterest().getCents();
     if (interest > 0) {
-        balance += interest;
-        
-        auto transaction = std::make_shared<Transaction>(
-            accountNumber, "Interest", interest, balance, getCurrentDateTime()
-        );
-        addTransaction(transaction);
+        recordTransaction("Interest", interest, credit(interest));
+        BankMetrics::shared().interestPostings.add();
     }
 }
 
+int Account::getInterestPeriodsPerYear() const {
+    return 1;
+}
+
+// Credits interest worked out elsewhere (the batch accrual kernel) and
+// returns the posting; the caller journals it, so a batch can append in bulk
+std::shared_ptr<Transaction> Account::postInterest(Money interest, const std::string& date) {
+    long long newBalance = credit(interest.getCents());
+    auto transaction = std::make_shared<Transaction>(
+        accountNumber, "Interest", interest, Money::fromCents(newBalance), date
+    );
+    addTransaction(transaction);
+    BankMetrics::shared().interestPostings.add();
+    return transaction;
+}
+
 // Validation methods
-bool Account::canWithdraw(double amount) const {
-    return amount > 0 && accountActive && balance >= amount + minimumBalance && 
+bool Account::canWithdraw(Money amount) const {
+    return amount > Money() && accountActive && getBalanceMoney() >= amount + minimumBalance && 
            isWithinDailyLimit(amount) && isWithinMonthlyLimit(amount);
 }
 
-bool Account::canTransfer(double amount) const {
+bool Account::canTransfer(Money amount) const {
     return canWithdraw(amount);
 }
 
-bool Account::isWithinDailyLimit(double amount) const {
-    return dailyWithdrawn + amount <= dailyWithdrawalLimit;
+bool Account::isWithinDailyLimit(Money amount) const {
+    return getDailyWithdrawnMoney() + amount <= dailyWithdrawalLimit;
 }
 
-bool Account::isWithinMonthlyLimit(double amount) const {
-    return monthlyWithdrawn + amount <= monthlyWithdrawalLimit;
+bool Account::isWithinMonthlyLimit(Money amount) const {
+    return getMonthlyWithdrawnMoney() + amount <= monthlyWithdrawalLimit;
 }
 
 // Virtual methods
@@ -192,7 +361,7 @@ std::string Account::getAccountDetails() const {
     std::ostringstream oss;
     oss << "Account Number: " << accountNumber << "\n"
         << "Type: " << accountType << "\n"
-        << "Balance: $" << std::fixed << std::setprecision(2) << balance << "\n"
+        << "Balance: $" << getBalanceMoney() << "\n"
         << "Interest Rate: " << interestRate << "%\n"
         << "Status: " << (accountActive ? "Active" : "Inactive") << "\n"
         << "Date Created: " << dateCreated;
@@ -204,21 +373,29 @@ void Account::displayInfo() const {
     std::cout << "                    ACCOUNT INFORMATION\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
     std::cout << getAccountDetails() << "\n";
-    std::cout << "Minimum Balance: $" << std::fixed << std::setprecision(2) << minimumBalance << "\n";
-    std::cout << "Daily Withdrawal Limit: $" << std::fixed << std::setprecision(2) << dailyWithdrawalLimit << "\n";
-    std::cout << "Monthly Withdrawal Limit: $" << std::fixed << std::setprecision(2) << monthlyWithdrawalLimit << "\n";
-    std::cout << "Daily Withdrawn: $" << std::fixed << std::setprecision(2) << dailyWithdrawn << "\n";
-    std::cout << "Monthly Withdrawn: $" << std::fixed << std::setprecision(2) << monthlyWithdrawn << "\n";
-    std::cout << "Number of Transactions: " << transactions.size() << "\n";
+    std::cout << "Minimum Balance: $" << minimumBalance << "\n";
+    std::cout << "Daily Withdrawal Limit: $" << dailyWithdrawalLimit << "\n";
+    std::cout << "Monthly Withdrawal Limit: $" << monthlyWithdrawalLimit << "\n";
+    std::cout << "Daily Withdrawn: $" << getDailyWithdrawnMoney() << "\n";
+    std::cout << "Monthly Withdrawn: $" << getMonthlyWithdrawnMoney() << "\n";
+    std::cout << "Number of Transactions: " << getTransactionCount() << "\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
 }
 
 std::string Account::toFileString() const {
+    long long daily = dailyWindow.load(std::memory_order_acquire);
+    long long monthly = monthlyWindow.load(std::memory_order_acquire);
+    
+    // The withdrawal windows are persisted as amounts plus the day they belong to
+    std::string lastTransactionDate = windowPeriod(daily) > 0 ? PeriodClock::dateFromDays(windowPeriod(daily))
+                                                              : dateCreated.substr(0, 10);
+    
     std::ostringstream oss;
-    oss << accountNumber << "|" << accountType << "|" << balance << "|" << interestRate << "|"
+    oss << accountNumber << "|" << accountType << "|" << getBalanceMoney() << "|" << interestRate << "|"
         << (accountActive ? "1" : "0") << "|" << dateCreated << "|" << customerId << "|"
         << minimumBalance << "|" << dailyWithdrawalLimit << "|" << monthlyWithdrawalLimit << "|"
-        << dailyWithdrawn << "|" << monthlyWithdrawn << "|" << lastTransactionDate;
+        << Money::fromCents(windowAmount(daily)) << "|" << Money::fromCents(windowAmount(monthly)) << "|" 
+        << lastTransactionDate;
     return oss.str();
 }
 
@@ -234,56 +411,141 @@ void Account::fromFileString(const std::string& data) {
     if (tokens.size() >= 13) {
         accountNumber = tokens[0];
         accountType = tokens[1];
-        balance = std::stod(tokens[2]);
+        storeBalance(Money::parse(tokens[2]).getCents());
         interestRate = std::stod(tokens[3]);
         accountActive = (tokens[4] == "1");
         dateCreated = tokens[5];
         customerId = tokens[6];
-        minimumBalance = std::stod(tokens[7]);
-        dailyWithdrawalLimit = std::stod(tokens[8]);
-        monthlyWithdrawalLimit = std::stod(tokens[9]);
-        dailyWithdrawn = std::stod(tokens[10]);
-        monthlyWithdrawn = std::stod(tokens[11]);
-        lastTransactionDate = tokens[12];
+        minimumBalance = Money::parse(tokens[7]);
+        dailyWithdrawalLimit = Money::parse(tokens[8]);
+        monthlyWithdrawalLimit = Money::parse(tokens[9]);
+        
+        long long day = 0;
+        long long month = 0;
+        int year = 0, mon = 0, mday = 0;
+        if (std::sscanf(tokens[12].c_str(), "%d-%d-%d", &year, &mon, &mday) == 3) {
+            day = PeriodClock::daysFromCivil(year, static_cast<unsigned>(mon), static_cast<unsigned>(mday));
+            month = year * 12LL + (mon - 1);
+        }
+        dailyWindow.store(packWindow(day, Money::parse(tokens[10]).getCents()));
+        monthlyWindow.store(packWindow(month, Money::parse(tokens[11]).getCents()));
     }
 }
 
 // Utility methods
 void Account::generateAccountNumber() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(100000000, 999999999);
-    accountNumber = std::to_string(dis(gen));
+    accountNumber = std::to_string(IdGenerator::shared().next(100000000, 999999999));
 }
 
 std::string Account::getCurrentDateTime() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    return PeriodClock::shared().timestamp(); // Reentrant; accounts are posted from many threads
 }
 
 void Account::resetDailyLimits() {
-    dailyWithdrawn = 0.0;
+    dailyWindow.store(packWindow(currentDayNumber(), 0), std::memory_order_release);
 }
 
 void Account::resetMonthlyLimits() {
-    monthlyWithdrawn = 0.0;
+    monthlyWindow.store(packWindow(currentMonthNumber(), 0), std::memory_order_release);
 }
 
 void Account::updateLimits() {
-    std::string currentDate = getCurrentDateTime();
-    
-    // Reset daily limits if it's a new day
-    if (currentDate.substr(0, 10) != lastTransactionDate.substr(0, 10)) {
+    // Windows from an earlier day/month count as empty; start fresh ones explicitly
+    if (windowPeriod(dailyWindow.load()) != currentDayNumber()) {
         resetDailyLimits();
     }
-    
-    // Reset monthly limits if it's a new month
-    if (currentDate.substr(0, 7) != lastTransactionDate.substr(0, 7)) {
+    if (windowPeriod(monthlyWindow.load()) != currentMonthNumber()) {
         resetMonthlyLimits();
     }
+}
+
+long long Account::toCents(double amount) {
+    return std::llround(amount * 100.0);
+}
+
+double Account::fromCents(long long cents) {
+    return static_cast<double>(cents) / 100.0;
+}
+
+// Lock-free balance primitives
+long long Account::credit(long long cents) {
+    long long balance = balanceCents.fetch_add(cents, std::memory_order_acq_rel) + cents;
+    publishBalanceChange(cents);
+    return balance;
+}
+
+bool Account::debit(long long cents, long long& newBalanceCents) {
+    long long day = currentDayNumber();
+    long long month = currentMonthNumber();
+    
+    // Reserve against the withdrawal limits first, then take the money
+    if (!reserveWindow(dailyWindow, day, cents, dailyWithdrawalLimit.getCents())) {
+        BankMetrics::shared().declinedDailyLimit.add();
+        return false;
+    }
+    if (!reserveWindow(monthlyWindow, month, cents, monthlyWithdrawalLimit.getCents())) {
+        releaseWindow(dailyWindow, day, cents);
+        BankMetrics::shared().declinedMonthlyLimit.add();
+        return false;
+    }
+    
+    long long floor = minimumBalance.getCents();
+    long long current = balanceCents.load(std::memory_order_relaxed);
+    do {
+        if (current - cents < floor) {
+            releaseWindow(monthlyWindow, month, cents);
+            releaseWindow(dailyWindow, day, cents);
+            BankMetrics::shared().declinedMinimumBalance.add();
+            return false;
+        }
+    } while (!balanceCents.compare_exchange_weak(current, current - cents, std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed));
     
-    lastTransactionDate = currentDate;
+    publishBalanceChange(-cents);
+    newBalanceCents = current - cents;
+    return true;
+}
+
+void Account::storeBalance(long long cents) {
+    long long previous = balanceCents.exchange(cents, std::memory_order_acq_rel);
+    publishBalanceChange(cents - previous);
+}
+
+void Account::publishBalanceChange(long long deltaCents) {
+    if (statistics) {
+        statistics->addBalance(deltaCents);
+    }
+    if (owner) {
+        owner->adjustTotalBalance(deltaCents);
+    }
+}
+
+void Account::recordTransaction(const std::string& type, long long amountCents, long long balanceAfterCents) {
+    auto transaction = std::make_shared<Transaction>(
+        accountNumber, type, Money::fromCents(amountCents), Money::fromCents(balanceAfterCents), getCurrentDateTime()
+    );
+    if (journal) {
+        journal->append(transaction);
+    }
+    addTransaction(std::move(transaction));
+}
+
+// Memory accounting
+void Account::addMemoryUsage(MemoryReport& report) const {
+    report.addShared(MemorySubsystem::Accounts, getObjectSize());
+    for (const std::string* field : {&accountNumber, &accountType, &dateCreated, &customerId}) {
+        report.addString(*field);
+    }
+    size_t nodes = transactionCount.load(std::memory_order_relaxed);
+    report.add(MemorySubsystem::Lists, nodes, nodes * MemoryReport::allocationSize(sizeof(TransactionNode)));
+    if (archiveMaterialized.load(std::memory_order_acquire)) {
+        report.addVector(MemorySubsystem::Lists, archivedTransactions);
+        for (const auto& transaction : archivedTransactions) {
+            transaction->addMemoryUsage(report);
+        }
+    }
+}
+
+size_t Account::getObjectSize() const {
+    return sizeof(Account);
 }
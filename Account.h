@@ -5,44 +5,81 @@
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <functional>
+
+#include "Money.h"
 
 // Forward declaration
 class Transaction;
+class TransactionJournal;
+class TransactionArchive;
+class LedgerStatistics;
+class Customer;
+class MemoryReport;
 
 class Account {
 protected:
+    // Append-only, lock-free transaction history (newest first)
+    struct TransactionNode {
+        std::shared_ptr<Transaction> transaction;
+        TransactionNode* next;
+    };
+
     std::string accountNumber;
     std::string accountType;
-    double balance;
+    std::atomic<long long> balanceCents; // Integer cents, updated without locks
     double interestRate;
-    bool accountActive;
+    std::atomic<bool> accountActive; // Read by snapshots while the account posts
     std::string dateCreated;
     std::string customerId;
-    std::vector<std::shared_ptr<Transaction>> transactions;
-    double minimumBalance;
-    double dailyWithdrawalLimit;
-    double monthlyWithdrawalLimit;
-    double dailyWithdrawn;
-    double monthlyWithdrawn;
-    std::string lastTransactionDate;
+    std::atomic<TransactionNode*> transactionHead;
+    std::atomic<size_t> transactionCount;
+    Money minimumBalance;
+    Money dailyWithdrawalLimit;
+    Money monthlyWithdrawalLimit;
+    // Withdrawn cents packed with the day/month number they belong to,
+    // so the limit check and the window rollover are a single CAS
+    std::atomic<long long> dailyWindow;
+    std::atomic<long long> monthlyWindow;
+    TransactionJournal* journal; // Bank-wide journal every posting is mirrored to (optional)
+    LedgerStatistics* statistics; // Bank-wide totals every balance change is reported to (optional)
+    Customer* owner; // Customer whose cached total includes this balance (optional)
+    // History persisted by earlier runs, read from disk the first time it is asked for
+    const TransactionArchive* archive;
+    size_t archivedCount;
+    mutable std::once_flag archiveLoaded;
+    mutable std::atomic<bool> archiveMaterialized;
+    mutable std::vector<std::shared_ptr<Transaction>> archivedTransactions; // Oldest first
 
 public:
     // Constructors
     Account();
     Account(const std::string& customerId, const std::string& accountType, double initialBalance = 0.0);
+    Account(const Account&) = delete;
+    Account& operator=(const Account&) = delete;
     virtual ~Account();
 
     // Getters
     std::string getAccountNumber() const;
     std::string getAccountType() const;
     double getBalance() const;
+    long long getBalanceCents() const;
+    Money getBalanceMoney() const;
     double getInterestRate() const;
     bool isActive() const;
     std::string getDateCreated() const;
     std::string getCustomerId() const;
     double getMinimumBalance() const;
+    Money getMinimumBalanceMoney() const;
     double getDailyWithdrawalLimit() const;
     double getMonthlyWithdrawalLimit() const;
+    double getDailyWithdrawn() const;
+    double getMonthlyWithdrawn() const;
+    Money getDailyWithdrawnMoney() const;
+    Money getMonthlyWithdrawnMoney() const;
+    size_t getTransactionCount() const;
 
     // Setters
     void setAccountNumber(const std::string& number);
@@ -52,27 +89,50 @@ public:
     void setActive(bool active);
     void setDateCreated(const std::string& date);
     void setCustomerId(const std::string& id);
-    void setMinimumBalance(double amount);
-    void setDailyWithdrawalLimit(double limit);
-    void setMonthlyWithdrawalLimit(double limit);
+    void setMinimumBalance(Money amount);
+    void setDailyWithdrawalLimit(Money limit);
+    void setMonthlyWithdrawalLimit(Money limit);
+    void setJournal(TransactionJournal* journal);
+    void setStatistics(LedgerStatistics* statistics); // Moves this balance out of the old totals into the new
+    void setOwner(Customer* owner); // Likewise for the owner's cached total
+    void setArchive(const TransactionArchive* archive); // Older history stays on disk until first read
+    Customer* getOwner() const;
 
     // Transaction methods
-    virtual bool deposit(double amount);
-    virtual bool withdraw(double amount);
-    virtual bool transfer(Account& targetAccount, double amount);
+    virtual bool deposit(Money amount);
+    virtual bool withdraw(Money amount);
+    virtual bool transfer(Account& targetAccount, Money amount);
+    bool deposit(double amount);
+    bool withdraw(double amount);
+    bool transfer(Account& targetAccount, double amount);
     void addTransaction(std::shared_ptr<Transaction> transaction);
     std::vector<std::shared_ptr<Transaction>> getTransactions() const;
+    
+    // Visit the history newest first without copying it; stop when the visitor returns false.
+    // Archived transactions are streamed from disk unless already materialized,
+    // so a visited transaction is only valid for the duration of its visit
+    template <typename Visitor>
+    void forEachTransaction(Visitor visit) const {
+        for (TransactionNode* node = transactionHead.load(std::memory_order_acquire); node; node = node->next) {
+            if (!visit(*node->transaction)) {
+                return;
+            }
+        }
+        forEachArchivedTransaction(visit);
+    }
     void displayTransactionHistory() const;
 
     // Interest calculation
-    virtual double calculateInterest() const;
+    virtual Money calculateInterest() const;
     virtual void applyInterest();
+    virtual int getInterestPeriodsPerYear() const; // How often getInterestRate() is credited
+    std::shared_ptr<Transaction> postInterest(Money interest, const std::string& date);
 
     // Validation methods
-    virtual bool canWithdraw(double amount) const;
-    virtual bool canTransfer(double amount) const;
-    bool isWithinDailyLimit(double amount) const;
-    bool isWithinMonthlyLimit(double amount) const;
+    virtual bool canWithdraw(Money amount) const;
+    virtual bool canTransfer(Money amount) const;
+    bool isWithinDailyLimit(Money amount) const;
+    bool isWithinMonthlyLimit(Money amount) const;
 
     // Virtual methods for polymorphism
     virtual std::string getAccountDetails() const;
@@ -86,6 +146,22 @@ public:
     void resetDailyLimits();
     void resetMonthlyLimits();
     void updateLimits();
+    static long long toCents(double amount);
+    static double fromCents(long long cents);
+
+    // Memory accounting (posted transactions are counted with the journal, archived ones here)
+    void addMemoryUsage(MemoryReport& report) const;
+    virtual size_t getObjectSize() const;
+
+protected:
+    // Lock-free balance primitives shared by the account types
+    long long credit(long long cents);
+    bool debit(long long cents, long long& newBalanceCents);
+    void storeBalance(long long cents);
+    void publishBalanceChange(long long deltaCents);
+    void recordTransaction(const std::string& type, long long amountCents, long long balanceAfterCents);
+    const std::vector<std::shared_ptr<Transaction>>& getArchivedTransactions() const; // Materialized once
+    void forEachArchivedTransaction(const std::function<bool(const Transaction&)>& visit) const; // Newest first
 };
 
 #endif // ACCOUNT_H
@@ -0,0 +1,230 @@
+#include "AdmissionController.h"
+#include <chrono>
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+const size_t kMinSweepThreshold = 1024;
+
+int64_t intervalFor(double ratePerSecond) {
+    return ratePerSecond > 0.0 ? static_cast<int64_t>(1e9 / ratePerSecond) : 0;
+}
+
+int64_t toleranceFor(double ratePerSecond, double burst) {
+    if (ratePerSecond <= 0.0 || burst < 1.0) {
+        return 0;
+    }
+    return static_cast<int64_t>((burst - 1.0) * 1e9 / ratePerSecond);
+}
+
+} // namespace
+
+// TokenBucket
+TokenBucket::TokenBucket(double ratePerSecond, double burst)
+    : theoreticalArrival(0), intervalNanos(intervalFor(ratePerSecond)),
+      toleranceNanos(toleranceFor(ratePerSecond, burst)), admitted(0), throttled(0) {
+}
+
+void TokenBucket::configure(double ratePerSecond, double burst) {
+    intervalNanos.store(intervalFor(ratePerSecond), std::memory_order_relaxed);
+    toleranceNanos.store(toleranceFor(ratePerSecond, burst), std::memory_order_relaxed);
+    theoreticalArrival.store(0, std::memory_order_relaxed); // Start with a full bucket
+}
+
+bool TokenBucket::tryAcquire(int64_t nowNanos) {
+    int64_t interval = intervalNanos.load(std::memory_order_relaxed);
+    if (interval == 0) {
+        admitted.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    int64_t tolerance = toleranceNanos.load(std::memory_order_relaxed);
+
+    // Taking a token pushes the arrival time one interval into the future;
+    // a request is refused once that runs further ahead than the burst allows
+    int64_t arrival = theoreticalArrival.load(std::memory_order_relaxed);
+    while (true) {
+        int64_t start = std::max(arrival, nowNanos);
+        if (start - nowNanos > tolerance) {
+            throttled.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (theoreticalArrival.compare_exchange_weak(arrival, start + interval,
+                                                     std::memory_order_relaxed)) {
+            admitted.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+void TokenBucket::release() {
+    int64_t interval = intervalNanos.load(std::memory_order_relaxed);
+    if (interval != 0) {
+        theoreticalArrival.fetch_sub(interval, std::memory_order_relaxed);
+    }
+    admitted.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool TokenBucket::isFull(int64_t nowNanos) const {
+    return theoreticalArrival.load(std::memory_order_relaxed) <= nowNanos;
+}
+
+bool TokenBucket::isLimited() const {
+    return intervalNanos.load(std::memory_order_relaxed) != 0;
+}
+
+uint64_t TokenBucket::getAdmitted() const {
+    return admitted.load(std::memory_order_relaxed);
+}
+
+uint64_t TokenBucket::getThrottled() const {
+    return throttled.load(std::memory_order_relaxed);
+}
+
+// AdmissionController
+AdmissionController::AdmissionController()
+    : customerRate(0.0), customerBurst(1.0), customersLimited(false), sweepThreshold(kMinSweepThreshold),
+      admittedCount(0), throttledCustomerCount(0), throttledGlobalCount(0) {
+}
+
+// Configuration
+void AdmissionController::setGlobalLimit(double ratePerSecond, double burst) {
+    globalBucket.configure(ratePerSecond, burst);
+}
+
+void AdmissionController::setCustomerLimit(double ratePerSecond, double burst) {
+    std::unique_lock<std::shared_mutex> guard(bucketsLock);
+    customerRate = ratePerSecond;
+    customerBurst = burst;
+    customersLimited.store(customerRate > 0.0 || !customerOverrides.empty());
+    for (auto& entry : customerBuckets) {
+        if (customerOverrides.find(entry.first) == customerOverrides.end()) {
+            entry.second->configure(ratePerSecond, burst);
+        }
+    }
+}
+
+void AdmissionController::setCustomerOverride(const std::string& customerId, double ratePerSecond, double burst) {
+    std::unique_lock<std::shared_mutex> guard(bucketsLock);
+    customerOverrides[customerId] = std::make_pair(ratePerSecond, burst);
+    customersLimited.store(true);
+    auto it = customerBuckets.find(customerId);
+    if (it != customerBuckets.end()) {
+        it->second->configure(ratePerSecond, burst);
+    }
+}
+
+bool AdmissionController::isEnabled() const {
+    return globalBucket.isLimited() || customersLimited.load();
+}
+
+// Hot path
+AdmissionResult AdmissionController::admit(const std::string& customerId) {
+    // Unlimited (the default): no clock read, no lock, no bucket
+    bool globalLimited = globalBucket.isLimited();
+    if (!globalLimited && !customersLimited.load(std::memory_order_relaxed)) {
+        admittedCount.fetch_add(1, std::memory_order_relaxed);
+        return AdmissionResult::Admitted;
+    }
+    int64_t now = nowNanos();
+
+    // The customer's own bucket goes first, so a noisy customer is refused
+    // without draining the shared allowance everyone else depends on; if the
+    // shared bucket then refuses, the customer gets the token back
+    std::shared_ptr<TokenBucket> bucket;
+    if (customersLimited.load(std::memory_order_relaxed)) {
+        bucket = bucketFor(customerId, now);
+        if (!bucket->tryAcquire(now)) {
+            throttledCustomerCount.fetch_add(1, std::memory_order_relaxed);
+            return AdmissionResult::ThrottledCustomer;
+        }
+    }
+    if (globalLimited && !globalBucket.tryAcquire(now)) {
+        if (bucket) {
+            bucket->release();
+        }
+        throttledGlobalCount.fetch_add(1, std::memory_order_relaxed);
+        return AdmissionResult::ThrottledGlobal;
+    }
+    admittedCount.fetch_add(1, std::memory_order_relaxed);
+    return AdmissionResult::Admitted;
+}
+
+// Reporting
+AdmissionController::Statistics AdmissionController::getStatistics(size_t topCount) const {
+    Statistics stats;
+    stats.admitted = admittedCount.load(std::memory_order_relaxed);
+    stats.throttledCustomer = throttledCustomerCount.load(std::memory_order_relaxed);
+    stats.throttledGlobal = throttledGlobalCount.load(std::memory_order_relaxed);
+
+    std::shared_lock<std::shared_mutex> guard(bucketsLock);
+    stats.trackedCustomers = customerBuckets.size();
+    for (const auto& entry : customerBuckets) {
+        uint64_t shed = entry.second->getThrottled();
+        if (shed > 0) {
+            stats.topThrottled.emplace_back(entry.first, shed);
+        }
+    }
+    guard.unlock();
+
+    std::sort(stats.topThrottled.begin(), stats.topThrottled.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+    if (stats.topThrottled.size() > topCount) {
+        stats.topThrottled.resize(topCount);
+    }
+    return stats;
+}
+
+std::string AdmissionController::resultToString(AdmissionResult result) {
+    switch (result) {
+        case AdmissionResult::Admitted: return "Admitted";
+        case AdmissionResult::ThrottledCustomer: return "Throttled (customer limit)";
+        case AdmissionResult::ThrottledGlobal: return "Throttled (system limit)";
+    }
+    return "Unknown";
+}
+
+// Helper methods
+std::shared_ptr<TokenBucket> AdmissionController::bucketFor(const std::string& customerId, int64_t nowNanos) {
+    {
+        std::shared_lock<std::shared_mutex> guard(bucketsLock);
+        auto it = customerBuckets.find(customerId);
+        if (it != customerBuckets.end()) {
+            return it->second;
+        }
+    }
+
+    // First request from this customer, or the first since its bucket was
+    // swept; the shared pointer keeps a bucket alive for a caller racing a sweep
+    std::unique_lock<std::shared_mutex> guard(bucketsLock);
+    if (customerBuckets.size() >= sweepThreshold) {
+        sweepFullBuckets(nowNanos);
+    }
+    auto& bucket = customerBuckets[customerId];
+    if (!bucket) {
+        auto override = customerOverrides.find(customerId);
+        if (override != customerOverrides.end()) {
+            bucket = std::make_shared<TokenBucket>(override->second.first, override->second.second);
+        } else {
+            bucket = std::make_shared<TokenBucket>(customerRate, customerBurst);
+        }
+    }
+    return bucket;
+}
+
+void AdmissionController::sweepFullBuckets(int64_t nowNanos) {
+    for (auto it = customerBuckets.begin(); it != customerBuckets.end();) {
+        if (it->second->isFull(nowNanos) && it->second.use_count() == 1) {
+            it = customerBuckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // Sweep again once the map has doubled, so the cost stays amortized
+    sweepThreshold = std::max(kMinSweepThreshold, customerBuckets.size() * 2);
+}
+
+int64_t AdmissionController::nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
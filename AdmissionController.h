@@ -0,0 +1,91 @@
+#ifndef ADMISSION_CONTROLLER_H
+#define ADMISSION_CONTROLLER_H
+
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <shared_mutex>
+#include <vector>
+#include <cstdint>
+
+enum class AdmissionResult {
+    Admitted,
+    ThrottledCustomer,
+    ThrottledGlobal
+};
+
+// Token bucket kept as a single atomic "theoretical arrival time" (the GCRA
+// form), so a check is one load and one CAS with no lock. A rate of 0
+// disables the bucket.
+class TokenBucket {
+private:
+    std::atomic<int64_t> theoreticalArrival; // Nanoseconds on the steady clock
+    std::atomic<int64_t> intervalNanos;      // Time to earn one token
+    std::atomic<int64_t> toleranceNanos;     // Burst allowance
+    std::atomic<uint64_t> admitted;
+    std::atomic<uint64_t> throttled;
+
+public:
+    TokenBucket(double ratePerSecond = 0.0, double burst = 1.0);
+
+    void configure(double ratePerSecond, double burst);
+    bool tryAcquire(int64_t nowNanos);
+    void release();                      // Give back a token taken by tryAcquire
+    bool isFull(int64_t nowNanos) const; // Every token earned back; forgetting it changes nothing
+    bool isLimited() const;
+    uint64_t getAdmitted() const;
+    uint64_t getThrottled() const;
+};
+
+// Admission control in front of the transaction API: one bucket per
+// customer plus one shared by everybody. Customer buckets only exist while
+// they hold debt: once a bucket has refilled it is dropped on the next
+// sweep, and recreated full if the customer comes back.
+class AdmissionController {
+public:
+    struct Statistics {
+        uint64_t admitted;
+        uint64_t throttledCustomer;
+        uint64_t throttledGlobal;
+        size_t trackedCustomers;
+        std::vector<std::pair<std::string, uint64_t>> topThrottled; // Customer ID, requests shed (tracked customers)
+    };
+
+private:
+    TokenBucket globalBucket;
+    double customerRate;
+    double customerBurst;
+    std::unordered_map<std::string, std::shared_ptr<TokenBucket>> customerBuckets;
+    std::unordered_map<std::string, std::pair<double, double>> customerOverrides;
+    mutable std::shared_mutex bucketsLock;
+    std::atomic<bool> customersLimited; // A customer rate or any override is set
+    size_t sweepThreshold;              // Bucket count that triggers the next sweep for refilled buckets
+    std::atomic<uint64_t> admittedCount;
+    std::atomic<uint64_t> throttledCustomerCount;
+    std::atomic<uint64_t> throttledGlobalCount;
+
+public:
+    // Constructor
+    AdmissionController();
+
+    // Configuration (a rate of 0 means unlimited)
+    void setGlobalLimit(double ratePerSecond, double burst);
+    void setCustomerLimit(double ratePerSecond, double burst);
+    void setCustomerOverride(const std::string& customerId, double ratePerSecond, double burst);
+    bool isEnabled() const;
+
+    // Hot path
+    AdmissionResult admit(const std::string& customerId);
+
+    // Reporting
+    Statistics getStatistics(size_t topCount = 5) const;
+    static std::string resultToString(AdmissionResult result);
+
+private:
+    std::shared_ptr<TokenBucket> bucketFor(const std::string& customerId, int64_t nowNanos);
+    void sweepFullBuckets(int64_t nowNanos); // Caller holds bucketsLock exclusively
+    static int64_t nowNanos();
+};
+
+#endif // ADMISSION_CONTROLLER_H
@@ -0,0 +1,154 @@
+#include "AmortizationEngine.h"
+#include "PeriodClock.h"
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+
+namespace {
+
+bool parseDate(const std::string& date, int& year, int& month, int& day) {
+    return std::sscanf(date.c_str(), "%d-%d-%d", &year, &month, &day) == 3 &&
+           month >= 1 && month <= 12 && day >= 1 && day <= 31;
+}
+
+std::string formatDate(int year, int month, int day) {
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
+
+int daysInMonth(int year, int month) {
+    static const int lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : lengths[month - 1];
+}
+
+} // namespace
+
+std::string AmortizationSchedule::getDueDate(int period) const {
+    // Counted from the start so a 31st doesn't drift to the 28th after February
+    return AmortizationEngine::addMonths(startDate, period);
+}
+
+AmortizationEngine& AmortizationEngine::shared() {
+    static AmortizationEngine engine;
+    return engine;
+}
+
+double AmortizationEngine::getPaymentFactor(double annualRatePercent, int termMonths) {
+    if (termMonths <= 0) {
+        return 0.0;
+    }
+    uint64_t key = (static_cast<uint64_t>(Money::rateToMicros(annualRatePercent)) << 20) |
+                   static_cast<uint64_t>(termMonths & 0xFFFFF);
+    {
+        std::shared_lock<std::shared_mutex> guard(cacheLock);
+        auto it = factorCache.find(key);
+        if (it != factorCache.end()) {
+            return it->second;
+        }
+    }
+
+    double monthlyRate = annualRatePercent / 100.0 / 12.0;
+    double factor = monthlyRate > 0.0 ? monthlyRate / (1.0 - std::pow(1.0 + monthlyRate, -termMonths))
+                                      : 1.0 / termMonths;
+
+    std::unique_lock<std::shared_mutex> guard(cacheLock);
+    factorCache.emplace(key, factor);
+    return factor;
+}
+
+Money AmortizationEngine::getMonthlyPayment(Money principal, double annualRatePercent, int termMonths) {
+    return Money::fromDouble(principal.toDouble() * getPaymentFactor(annualRatePercent, termMonths));
+}
+
+size_t AmortizationEngine::getCachedFactorCount() const {
+    std::shared_lock<std::shared_mutex> guard(cacheLock);
+    return factorCache.size();
+}
+
+std::shared_ptr<const AmortizationSchedule> AmortizationEngine::buildSchedule(Money balance, double annualRatePercent,
+                                                                              int termMonths, int paymentsMade,
+                                                                              Money monthlyPayment,
+                                                                              const std::string& startDate) {
+    auto schedule = std::make_shared<AmortizationSchedule>();
+    schedule->startDate = startDate;
+    schedule->monthlyPayment = monthlyPayment;
+
+    int remainingPeriods = termMonths - paymentsMade;
+    if (remainingPeriods < 1) {
+        remainingPeriods = 1; // Past term: the whole balance is due now
+    }
+    schedule->rows.reserve(static_cast<size_t>(remainingPeriods));
+
+    // Level payments until the balance runs out; the final row settles whatever is left
+    int64_t rateMicros = Money::rateToMicros(annualRatePercent);
+    for (int i = 0; i < remainingPeriods && balance > Money(); ++i) {
+        AmortizationRow row;
+        row.period = paymentsMade + i + 1;
+        row.interest = balance.interestAtMicros(rateMicros, 12);
+        row.principal = monthlyPayment - row.interest;
+        if (i == remainingPeriods - 1 || row.principal >= balance) {
+            row.principal = balance;
+        }
+        if (row.principal < Money()) {
+            row.principal = Money(); // Payment doesn't cover interest
+        }
+        row.payment = row.interest + row.principal;
+        balance -= row.principal;
+        row.balance = balance;
+        schedule->totalInterest += row.interest;
+        schedule->rows.push_back(row);
+    }
+    return schedule;
+}
+
+int AmortizationEngine::getPeriodsCovered(Money principal, double annualRatePercent, int termMonths,
+                                          Money monthlyPayment, Money balance) {
+    int64_t rateMicros = Money::rateToMicros(annualRatePercent);
+    Money scheduled = principal;
+    int covered = 0;
+    while (covered < termMonths && scheduled > Money()) {
+        Money interest = scheduled.interestAtMicros(rateMicros, 12);
+        Money principalPaid = monthlyPayment - interest;
+        if (covered + 1 == termMonths || principalPaid >= scheduled) {
+            principalPaid = scheduled;
+        }
+        if (principalPaid < Money()) {
+            principalPaid = Money();
+        }
+        Money next = scheduled - principalPaid;
+        if (next < balance) {
+            break; // The next payment is still owed
+        }
+        scheduled = next;
+        covered++;
+    }
+    return covered;
+}
+
+// Date helpers
+std::string AmortizationEngine::addMonths(const std::string& date, int months) {
+    int year, month, day;
+    if (!parseDate(date, year, month, day)) {
+        return date;
+    }
+    int monthIndex = year * 12 + (month - 1) + months;
+    year = monthIndex / 12;
+    month = monthIndex % 12 + 1;
+    int length = daysInMonth(year, month);
+    return formatDate(year, month, day > length ? length : day);
+}
+
+int AmortizationEngine::daysBetween(const std::string& from, const std::string& to) {
+    int fromYear, fromMonth, fromDay, toYear, toMonth, toDay;
+    if (!parseDate(from, fromYear, fromMonth, fromDay) || !parseDate(to, toYear, toMonth, toDay)) {
+        return 0;
+    }
+    return static_cast<int>(PeriodClock::daysFromCivil(toYear, toMonth, toDay) -
+                            PeriodClock::daysFromCivil(fromYear, fromMonth, fromDay));
+}
+
+std::string AmortizationEngine::today() {
+    return PeriodClock::shared().timestamp().substr(0, 10);
+}
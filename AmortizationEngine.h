@@ -0,0 +1,69 @@
+#ifndef AMORTIZATION_ENGINE_H
+#define AMORTIZATION_ENGINE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <shared_mutex>
+#include <cstdint>
+
+#include "Money.h"
+
+// One period of a repayment schedule
+struct AmortizationRow {
+    int period;        // 1-based, counted from the first payment of the loan
+    Money payment;
+    Money interest;
+    Money principal;
+    Money balance;     // Outstanding after this payment
+};
+
+// Remaining repayment plan of a loan, from its next payment to payoff
+struct AmortizationSchedule {
+    std::string startDate;     // Disbursement date; period n falls due n months later
+    Money monthlyPayment;
+    Money totalInterest;       // Interest still to be paid
+    std::vector<AmortizationRow> rows;
+
+    std::string getDueDate(int period) const;
+};
+
+// Builds level-payment amortization schedules.
+//
+// The payment factor r / (1 - (1 + r)^-n) depends only on the rate and the
+// term, and a loan book has few distinct pairs of those, so factors are
+// computed once (with a single pow) and shared by every loan that uses
+// them. Interest per period is rounded half to even like all other interest.
+class AmortizationEngine {
+private:
+    std::unordered_map<uint64_t, double> factorCache; // Keyed by rate micros and term
+    mutable std::shared_mutex cacheLock;
+
+public:
+    // Process-wide engine shared by all loans
+    static AmortizationEngine& shared();
+
+    double getPaymentFactor(double annualRatePercent, int termMonths);
+    Money getMonthlyPayment(Money principal, double annualRatePercent, int termMonths);
+    size_t getCachedFactorCount() const;
+
+    // Schedule for balance outstanding after paymentsMade payments of the level payment
+    std::shared_ptr<const AmortizationSchedule> buildSchedule(Money balance, double annualRatePercent,
+                                                              int termMonths, int paymentsMade,
+                                                              Money monthlyPayment,
+                                                              const std::string& startDate);
+
+    // Scheduled payments a loan is up to date with: the number of level
+    // payments after which the original schedule's balance is still at or
+    // above the balance actually outstanding
+    int getPeriodsCovered(Money principal, double annualRatePercent, int termMonths, Money monthlyPayment,
+                          Money balance);
+
+    // Date helpers (YYYY-MM-DD)
+    static std::string addMonths(const std::string& date, int months);
+    static int daysBetween(const std::string& from, const std::string& to);
+    static std::string today();
+};
+
+#endif // AMORTIZATION_ENGINE_H
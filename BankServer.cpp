@@ -0,0 +1,481 @@
+#include "BankServer.h"
+#include "BankingSystem.h"
+#include "WorkloadRecording.h"
+#include "MetricsRegistry.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const int kMaxEvents = 256;
+const size_t kMaxLineLength = 4096;
+
+// Amounts on the wire are decimal text, parsed straight to cents
+bool readAmount(std::istringstream& iss, Money& amount) {
+    std::string text;
+    if (!(iss >> text)) {
+        return false;
+    }
+    try {
+        amount = Money::parse(text);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+std::string errorResponse(OperationStatus status) {
+    return "ERR " + BankingSystem::statusToString(status);
+}
+
+#ifdef __linux__
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+} // namespace
+
+BankServer::BankServer(BankingSystem& bank)
+    : bank(bank), listenFd(-1), epollFd(-1), running(false), requestsServed(0), nextSessionId(0),
+      recorder(nullptr) {}
+
+BankServer::~BankServer() {
+    BankMetrics::shared().activeSessions.add(-static_cast<int64_t>(connections.size()));
+#ifdef __linux__
+    for (const auto& entry : connections) {
+        close(entry.first);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+    if (!socketPath.empty()) {
+        unlink(socketPath.c_str());
+    }
+#endif
+}
+
+// Listening endpoints
+bool BankServer::listenUnix(const std::string& path) {
+#ifdef __linux__
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "socket: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << path << "\n";
+        return false;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd, SOMAXCONN) < 0) {
+        std::cerr << "bind/listen " << path << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    socketPath = path;
+    return setNonBlocking(listenFd) && setupEpoll();
+#else
+    (void)path;
+    std::cerr << "Server mode requires Linux (epoll).\n";
+    return false;
+#endif
+}
+
+bool BankServer::listenTcp(int port) {
+#ifdef __linux__
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "socket: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Local clients only
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd, SOMAXCONN) < 0) {
+        std::cerr << "bind/listen 127.0.0.1:" << port << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    return setNonBlocking(listenFd) && setupEpoll();
+#else
+    (void)port;
+    std::cerr << "Server mode requires Linux (epoll).\n";
+    return false;
+#endif
+}
+
+// Event loop
+void BankServer::run() {
+#ifdef __linux__
+    if (epollFd < 0) {
+        return;
+    }
+
+    running = true;
+    epoll_event events[kMaxEvents];
+
+    while (running) {
+        // Short timeout so stop() is honoured without a wakeup fd
+        int ready = epoll_wait(epollFd, events, kMaxEvents, 100);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "epoll_wait: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                closeConnection(fd);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                handleReadable(it->second);
+            }
+
+            it = connections.find(fd);
+            if (it == connections.end()) continue;
+            if (events[i].events & EPOLLOUT || !it->second.writeBuffer.empty()) {
+                flushWrites(it->second);
+            }
+        }
+    }
+#endif
+}
+
+void BankServer::stop() {
+    running = false;
+}
+
+unsigned long long BankServer::getRequestsServed() const {
+    return requestsServed;
+}
+
+size_t BankServer::getConnectionCount() const {
+    return connections.size();
+}
+
+void BankServer::setRecorder(WorkloadRecorder* recorder) {
+    this->recorder = recorder;
+}
+
+// Protocol handling
+std::string BankServer::handleRequest(const std::string& line, std::shared_ptr<Customer>& session) {
+    std::istringstream iss(line);
+    std::string command;
+    iss >> command;
+    requestsServed++;
+    BankMetrics::shared().requests.add();
+
+    if (command == "REGISTER") {
+        std::string name, email, password;
+        if (!(iss >> name >> email >> password)) return "ERR Usage: REGISTER <name> <email> <password>";
+        auto customer = bank.createCustomer(name, email, "", "", password);
+        return "OK " + customer->getAccountNumber();
+    }
+
+    if (command == "LOGIN") {
+        std::string accountNumber, password;
+        if (!(iss >> accountNumber >> password)) return "ERR Usage: LOGIN <account> <password>";
+        auto customer = bank.authenticateUser(accountNumber, password);
+        if (!customer) return "ERR Invalid credentials";
+        session = customer;
+        return "OK " + customer->getUserId();
+    }
+
+    if (command == "QUIT") {
+        return "OK Bye";
+    }
+
+    if (command == "LATENCY") {
+        return "OK " + bank.dumpLatency();
+    }
+
+    if (command == "BATCH") {
+        std::string jobName = bank.getBatchJobName();
+        const BatchProgress& progress = bank.getBatchProgress();
+        if (jobName.empty() || !progress.running.load()) {
+            return "OK idle";
+        }
+        return "OK " + jobName + " " + std::to_string(progress.completedItems.load()) + "/" +
+               std::to_string(progress.totalItems.load());
+    }
+
+    if (!session) {
+        return "ERR Not logged in";
+    }
+
+    if (command == "OPEN") {
+        std::string accountType;
+        Money initialDeposit;
+        if (!(iss >> accountType) || !readAmount(iss, initialDeposit)) return "ERR Usage: OPEN <type> <initialDeposit>";
+        if (accountType != "Savings" && accountType != "Checking") return "ERR Unknown account type";
+        if (initialDeposit < Money()) return errorResponse(OperationStatus::InvalidAmount);
+        auto account = bank.createAccount(session->getUserId(), accountType, initialDeposit.toDouble());
+        return "OK " + account->getAccountNumber();
+    }
+
+    if (command == "ACCOUNTS") {
+        std::ostringstream oss;
+        oss << "OK";
+        for (const auto& account : session->getAllAccounts()) {
+            oss << " " << account->getAccountNumber() << ":" << account->getAccountType()
+                << ":" << account->getBalanceMoney();
+        }
+        return oss.str();
+    }
+
+    if (command == "BALANCE") {
+        std::string accountNumber;
+        if (!(iss >> accountNumber)) return "ERR Usage: BALANCE <account>";
+        if (!ownsAccount(session, accountNumber)) return errorResponse(OperationStatus::NotAuthorized);
+        return "OK " + bank.findAccount(accountNumber)->getBalanceMoney().toString();
+    }
+
+    if (command == "DEPOSIT" || command == "WITHDRAW") {
+        std::string accountNumber;
+        Money amount;
+        if (!(iss >> accountNumber) || !readAmount(iss, amount)) return "ERR Usage: " + command + " <account> <amount>";
+        if (!ownsAccount(session, accountNumber)) return errorResponse(OperationStatus::NotAuthorized);
+
+        OperationStatus status = command == "DEPOSIT" ? bank.deposit(accountNumber, amount)
+                                                      : bank.withdraw(accountNumber, amount);
+        if (status != OperationStatus::Success) return errorResponse(status);
+        return "OK " + bank.findAccount(accountNumber)->getBalanceMoney().toString();
+    }
+
+    if (command == "TRANSFER") {
+        std::string sourceAccount, targetAccount;
+        Money amount;
+        if (!(iss >> sourceAccount >> targetAccount) || !readAmount(iss, amount)) {
+            return "ERR Usage: TRANSFER <fromAccount> <toAccount> <amount>";
+        }
+        if (!ownsAccount(session, sourceAccount)) return errorResponse(OperationStatus::NotAuthorized);
+
+        OperationStatus status = bank.transfer(sourceAccount, targetAccount, amount);
+        if (status != OperationStatus::Success) return errorResponse(status);
+        return "OK " + bank.findAccount(sourceAccount)->getBalanceMoney().toString();
+    }
+
+    if (command == "LOAN") {
+        std::string loanType;
+        Money amount;
+        int termMonths = 0;
+        if (!(iss >> loanType) || !readAmount(iss, amount) || !(iss >> termMonths)) return "ERR Usage: LOAN <type> <amount> <termMonths>";
+        if (loanType != "Personal" && loanType != "Home" && loanType != "Business" && loanType != "Education") {
+            return "ERR Unknown loan type";
+        }
+        if (!bank.validateAmount(amount)) return errorResponse(OperationStatus::InvalidAmount);
+        if (termMonths <= 0 || termMonths > 360) return "ERR Invalid term";
+        if (!session->isEligibleForLoan()) return "ERR Not eligible for a loan";
+
+        auto loan = bank.requestLoan(session, loanType, amount, termMonths);
+        return "OK " + loan->getLoanId();
+    }
+
+    if (command == "PAYLOAN") {
+        std::string loanId;
+        Money amount;
+        if (!(iss >> loanId) || !readAmount(iss, amount)) return "ERR Usage: PAYLOAN <loanId> <amount>";
+        auto loan = bank.findLoan(loanId);
+        if (!loan) return errorResponse(OperationStatus::LoanNotFound);
+        if (loan->getCustomerId() != session->getUserId()) return errorResponse(OperationStatus::NotAuthorized);
+
+        OperationStatus status = bank.payLoan(loanId, amount);
+        if (status != OperationStatus::Success) return errorResponse(status);
+        return "OK " + loan->getRemainingBalanceMoney().toString();
+    }
+
+    return "ERR Unknown command";
+}
+
+// Helper methods
+bool BankServer::setupEpoll() {
+#ifdef __linux__
+    epollFd = epoll_create1(0);
+    if (epollFd < 0) {
+        std::cerr << "epoll_create1: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+#else
+    return false;
+#endif
+}
+
+void BankServer::acceptConnections() {
+#ifdef __linux__
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "accept: " << std::strerror(errno) << "\n";
+            }
+            return;
+        }
+
+        setNonBlocking(fd);
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)); // Fails harmlessly on AF_UNIX
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        connections[fd] = Connection{fd, "", "", nullptr, false, false, ++nextSessionId};
+        BankMetrics::shared().activeSessions.add(1);
+    }
+#endif
+}
+
+void BankServer::handleReadable(Connection& connection) {
+#ifdef __linux__
+    char buffer[16384];
+    while (true) {
+        ssize_t n = read(connection.fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            connection.readBuffer.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n == 0) {
+            connection.closing = true; // Peer closed; answer what we have first
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            closeConnection(connection.fd);
+            return;
+        }
+        break;
+    }
+
+    size_t start = 0;
+    size_t newline;
+    while ((newline = connection.readBuffer.find('\n', start)) != std::string::npos) {
+        std::string line = connection.readBuffer.substr(start, newline - start);
+        start = newline + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        std::string response = handleRequest(line, connection.customer);
+        if (recorder) {
+            recorder->record(connection.sessionId, line, response);
+        }
+        connection.writeBuffer += response;
+        connection.writeBuffer += '\n';
+        if (line == "QUIT") {
+            connection.closing = true;
+            break;
+        }
+    }
+    connection.readBuffer.erase(0, start);
+
+    if (connection.readBuffer.size() > kMaxLineLength) {
+        connection.writeBuffer += "ERR Line too long\n";
+        connection.readBuffer.clear();
+        connection.closing = true;
+    }
+
+    if (connection.closing && connection.writeBuffer.empty()) {
+        closeConnection(connection.fd);
+    }
+#else
+    (void)connection;
+#endif
+}
+
+void BankServer::flushWrites(Connection& connection) {
+#ifdef __linux__
+    while (!connection.writeBuffer.empty()) {
+        ssize_t n = write(connection.fd, connection.writeBuffer.data(), connection.writeBuffer.size());
+        if (n > 0) {
+            connection.writeBuffer.erase(0, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        closeConnection(connection.fd);
+        return;
+    }
+
+    if (connection.writeBuffer.empty() && connection.closing) {
+        closeConnection(connection.fd);
+        return;
+    }
+
+    // Only ask for EPOLLOUT while output is pending, otherwise it fires continuously
+    bool wantWrites = !connection.writeBuffer.empty();
+    if (wantWrites != connection.watchingWrites) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (wantWrites ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        event.data.fd = connection.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.watchingWrites = wantWrites;
+    }
+#else
+    (void)connection;
+#endif
+}
+
+void BankServer::closeConnection(int fd) {
+#ifdef __linux__
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+#endif
+    if (connections.erase(fd) > 0) {
+        BankMetrics::shared().activeSessions.add(-1);
+    }
+}
+
+bool BankServer::ownsAccount(const std::shared_ptr<Customer>& customer, const std::string& accountNumber) {
+    auto account = bank.findAccount(accountNumber);
+    return account && account->getCustomerId() == customer->getUserId();
+}
@@ -0,0 +1,84 @@
+#ifndef BANK_SERVER_H
+#define BANK_SERVER_H
+
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+
+class BankingSystem;
+class Customer;
+class WorkloadRecorder;
+
+// Line-oriented network front end for BankingSystem.
+//
+// One request per line, space separated; one response line per request,
+// starting with "OK" or "ERR":
+//   REGISTER <name> <email> <password>      -> OK <customerAccountNumber>
+//   LOGIN <customerAccountNumber> <password> -> OK <customerId>
+//   OPEN <Savings|Checking> <initialDeposit> -> OK <accountNumber>
+//   ACCOUNTS                                 -> OK <account>:<type>:<balance> ...
+//   BALANCE <account>                        -> OK <balance>
+//   DEPOSIT <account> <amount>               -> OK <balance>
+//   WITHDRAW <account> <amount>              -> OK <balance>
+//   TRANSFER <fromAccount> <toAccount> <amount> -> OK <balance>
+//   LOAN <type> <amount> <termMonths>        -> OK <loanId>
+//   PAYLOAN <loanId> <amount>                -> OK <remainingBalance>
+//   LATENCY                                  -> OK <op>:<count>:<p50>:<p99>:<p999>:<max> ... (ns)
+//   BATCH                                    -> OK idle | OK <job> <completedItems>/<totalItems>
+//   QUIT
+//
+// All connections are multiplexed on a single epoll event loop, which also
+// serializes every ledger operation handed to the engine.
+class BankServer {
+private:
+    struct Connection {
+        int fd;
+        std::string readBuffer;
+        std::string writeBuffer;
+        std::shared_ptr<Customer> customer;
+        bool closing;
+        bool watchingWrites;
+        unsigned long long sessionId; // Never reused, unlike the fd
+    };
+
+    BankingSystem& bank;
+    int listenFd;
+    int epollFd;
+    std::string socketPath;
+    std::atomic<bool> running;
+    std::unordered_map<int, Connection> connections;
+    unsigned long long requestsServed;
+    unsigned long long nextSessionId;
+    WorkloadRecorder* recorder; // Captures every request and response (optional)
+
+public:
+    // Constructor and destructor
+    explicit BankServer(BankingSystem& bank);
+    ~BankServer();
+
+    // Listening endpoints
+    bool listenUnix(const std::string& path);
+    bool listenTcp(int port);
+
+    // Event loop
+    void run();
+    void stop();
+    unsigned long long getRequestsServed() const;
+    size_t getConnectionCount() const;
+    void setRecorder(WorkloadRecorder* recorder);
+
+    // Protocol handling (exposed for reuse by in-process callers)
+    std::string handleRequest(const std::string& line, std::shared_ptr<Customer>& session);
+
+private:
+    // Helper methods
+    bool setupEpoll();
+    void acceptConnections();
+    void handleReadable(Connection& connection);
+    void flushWrites(Connection& connection);
+    void closeConnection(int fd);
+    bool ownsAccount(const std::shared_ptr<Customer>& customer, const std::string& accountNumber);
+};
+
+#endif // BANK_SERVER_H
@@ -1,21 +1,31 @@
 #include "BankingSystem.h"
+#include "InterestKernel.h"
+#include "PeriodClock.h"
+#include "StatementGenerator.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <ctime>
 #include <thread>
 #include <algorithm>
 #include <filesystem>
 
-BankingSystem::BankingSystem() : totalDeposits(0.0), totalWithdrawals(0.0), totalLoans(0.0),
-                                 totalCustomers(0), totalAccounts(0), totalTransactions(0) {
+BankingSystem::BankingSystem() : ledgerEpoch(0), postingsInFlight(0), snapshotBarrier(false),
+                                 batchJobName(nullptr), rolloverStopping(false), loanVersion(0), savedJournalSize(0) {
     customersFile = "customers.txt";
     accountsFile = "accounts.txt";
     transactionsFile = "transactions.txt";
     loansFile = "loans.txt";
+    loanPaymentsFile = "loan_payments.txt";
+    loanPayments.open(loanPaymentsFile);
+    transactions.setStatistics(&statistics);
+    registerMetrics();
 }
 
 BankingSystem::~BankingSystem() {
+    MetricsRegistry::shared().removeCallbacks(this);
+    stopRolloverScheduler();
     saveData();
 }
 
@@ -23,22 +33,29 @@ BankingSystem::~BankingSystem() {
 std::shared_ptr<Customer> BankingSystem::createCustomer(const std::string& name, const std::string& email, 
                                                         const std::string& phone, const std::string& address, 
                                                         const std::string& password) {
+    PostingScope posting(*this);
     auto customer = std::make_shared<Customer>(name, email, phone, address, password);
-    customers.push_back(customer);
-    totalCustomers++;
+    {
+        std::lock_guard<std::mutex> guard(customersMutex);
+        customers.push_back(customer);
+    }
+    customersByAccountNumber[customer->getAccountNumber()] = customer;
+    customersById[customer->getUserId()] = customer;
     return customer;
 }
 
 std::shared_ptr<Customer> BankingSystem::findCustomer(const std::string& accountNumber) {
-    for (const auto& customer : customers) {
-        if (customer->getAccountNumber() == accountNumber) {
-            return customer;
-        }
-    }
-    return nullptr;
+    auto it = customersByAccountNumber.find(accountNumber);
+    return it != customersByAccountNumber.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<Customer> BankingSystem::findCustomerById(const std::string& customerId) {
+    auto it = customersById.find(customerId);
+    return it != customersById.end() ? it->second : nullptr;
 }
 
 std::shared_ptr<Customer> BankingSystem::authenticateUser(const std::string& accountNumber, const std::string& password) {
+    LatencyTimer timer(latency, LatencyOperation::Authenticate);
     auto customer = findCustomer(accountNumber);
     if (customer && customer->authenticate(password)) {
         return customer;
@@ -70,6 +87,13 @@ void BankingSystem::displayAllCustomers() const {
 }
 
 void BankingSystem::deleteCustomer(const std::string& accountNumber) {
+    PostingScope posting(*this);
+    auto customer = findCustomer(accountNumber);
+    if (customer) {
+        customersById.erase(customer->getUserId());
+        customersByAccountNumber.erase(accountNumber);
+    }
+    std::lock_guard<std::mutex> guard(customersMutex);
     customers.erase(
         std::remove_if(customers.begin(), customers.end(),
             [&accountNumber](const std::shared_ptr<Customer>& customer) {
@@ -77,12 +101,12 @@ void BankingSystem::deleteCustomer(const std::string& accountNumber) {
             }),
         customers.end()
     );
-    totalCustomers--;
 }
 
 // Account management
 std::shared_ptr<Account> BankingSystem::createAccount(const std::string& customerId, const std::string& accountType, 
                                                       double initialBalance) {
+    PostingScope posting(*this);
     std::shared_ptr<Account> account;
     
     if (accountType == "Savings") {
@@ -91,11 +115,16 @@ std::shared_ptr<Account> BankingSystem::createAccount(const std::string& custome
         account = std::make_shared<Account>(customerId, accountType, initialBalance);
     }
     
-    accounts.push_back(account);
-    totalAccounts++;
+    account->setJournal(&transactions);
+    account->setStatistics(&statistics);
+    {
+        std::lock_guard<std::mutex> guard(accountsMutex);
+        accounts.push_back(account);
+    }
+    accountIndex[account->getAccountNumber()] = account;
     
     // Add account to customer
-    auto customer = findCustomer(customerId);
+    auto customer = findCustomerById(customerId);
     if (customer) {
         customer->addAccount(account);
     }
@@ -104,12 +133,8 @@ std::shared_ptr<Account> BankingSystem::createAccount(const std::string& custome
 }
 
 std::shared_ptr<Account> BankingSystem::findAccount(const std::string& accountNumber) {
-    for (const auto& account : accounts) {
-        if (account->getAccountNumber() == accountNumber) {
-            return account;
-        }
-    }
-    return nullptr;
+    auto it = accountIndex.find(accountNumber);
+    return it != accountIndex.end() ? it->second : nullptr;
 }
 
 void BankingSystem::displayAllAccounts() const {
@@ -117,7 +142,8 @@ void BankingSystem::displayAllAccounts() const {
     std::cout << "                    ALL ACCOUNTS\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
     
-    if (accounts.empty()) {
+    auto snapshot = pinSnapshot();
+    if (snapshot->accounts.empty()) {
         std::cout << "No accounts found.\n";
     } else {
         std::cout << std::setw(15) << "Account No." << std::setw(15) << "Type" 
@@ -125,12 +151,13 @@ void BankingSystem::displayAllAccounts() const {
                   << std::setw(15) << "Status\n";
         std::cout << std::string(75, '-') << "\n";
         
-        for (const auto& account : accounts) {
-            std::cout << std::setw(15) << account->getAccountNumber()
-                      << std::setw(15) << account->getAccountType()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << account->getBalance()
-                      << std::setw(15) << account->getCustomerId()
-                      << std::setw(15) << (account->isActive() ? "Active" : "Inactive") << "\n";
+        for (size_t i = 0; i < snapshot->accounts.size(); ++i) {
+            const auto& row = snapshot->accounts[i];
+            std::cout << std::setw(15) << row.account->getAccountNumber()
+                      << std::setw(15) << row.account->getAccountType()
+                      << std::setw(15) << "$" << snapshot->balances[i]
+                      << std::setw(15) << row.account->getCustomerId()
+                      << std::setw(15) << (row.active ? "Active" : "Inactive") << "\n";
         }
     }
     
@@ -138,6 +165,20 @@ void BankingSystem::displayAllAccounts() const {
 }
 
 void BankingSystem::deleteAccount(const std::string& accountNumber) {
+    PostingScope posting(*this);
+    auto account = findAccount(accountNumber);
+    if (!account) {
+        return;
+    }
+    // Move the balance out of the bank totals and the owner's cached total
+    account->setStatistics(nullptr);
+    auto customer = findCustomerById(account->getCustomerId());
+    if (customer) {
+        customer->removeAccount(accountNumber);
+    }
+    account->setOwner(nullptr);
+    accountIndex.erase(accountNumber);
+    std::lock_guard<std::mutex> guard(accountsMutex);
     accounts.erase(
         std::remove_if(accounts.begin(), accounts.end(),
             [&accountNumber](const std::shared_ptr<Account>& account) {
@@ -145,7 +186,6 @@ void BankingSystem::deleteAccount(const std::string& accountNumber) {
             }),
         accounts.end()
     );
-    totalAccounts--;
 }
 
 // Transaction management
@@ -178,9 +218,7 @@ bool BankingSystem::processDeposit(std::shared_ptr<Customer> customer) {
     
     if (choice > 0 && choice <= static_cast<int>(accounts.size())) {
         auto account = accounts[choice - 1];
-        if (account->deposit(amount)) {
-            totalDeposits += amount;
-            totalTransactions++;
+        if (deposit(account->getAccountNumber(), Money::fromDouble(amount)) == OperationStatus::Success) {
             std::cout << "Deposit successful! New balance: $"
                       << std::fixed << std::setprecision(2) << account->getBalance() << "\n";
             return true;
@@ -223,9 +261,7 @@ bool BankingSystem::processWithdrawal(std::shared_ptr<Customer> customer) {
     
     if (choice > 0 && choice <= static_cast<int>(accounts.size())) {
         auto account = accounts[choice - 1];
-        if (account->withdraw(amount)) {
-            totalWithdrawals += amount;
-            totalTransactions++;
+        if (withdraw(account->getAccountNumber(), Money::fromDouble(amount)) == OperationStatus::Success) {
             std::cout << "Withdrawal successful! New balance: $"
                       << std::fixed << std::setprecision(2) << account->getBalance() << "\n";
             return true;
@@ -279,8 +315,7 @@ bool BankingSystem::processTransfer(std::shared_ptr<Customer> customer) {
     
     if (choice > 0 && choice <= static_cast<int>(sourceAccounts.size())) {
         auto sourceAccount = sourceAccounts[choice - 1];
-        if (sourceAccount->transfer(*targetAccount, amount)) {
-            totalTransactions++;
+        if (transfer(sourceAccount->getAccountNumber(), targetAccountNumber, Money::fromDouble(amount)) == OperationStatus::Success) {
             std::cout << "Transfer successful!\n";
             std::cout << "Source account balance: $"
                       << std::fixed << std::setprecision(2) << sourceAccount->getBalance() << "\n";
@@ -326,7 +361,8 @@ void BankingSystem::displayAllTransactions() const {
     std::cout << "                    ALL TRANSACTIONS\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
     
-    if (transactions.empty()) {
+    auto snapshot = pinSnapshot();
+    if (snapshot->archiveLength + snapshot->journalLength == 0) {
         std::cout << "No transactions found.\n";
     } else {
         std::cout << std::setw(20) << "Date" << std::setw(15) << "Account" 
@@ -334,13 +370,17 @@ void BankingSystem::displayAllTransactions() const {
                   << std::setw(15) << "Balance\n";
         std::cout << std::string(80, '-') << "\n";
         
-        for (const auto& transaction : transactions) {
-            std::cout << std::setw(20) << transaction->getDate()
-                      << std::setw(15) << transaction->getAccountNumber()
-                      << std::setw(15) << transaction->getType()
-                      << std::setw(15) << transaction->getFormattedAmount()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << transaction->getBalance() << "\n";
-        }
+        auto printRow = [](const Transaction& transaction) {
+            std::cout << std::setw(20) << transaction.getDate()
+                      << std::setw(15) << transaction.getAccountNumber()
+                      << std::setw(15) << transaction.getType()
+                      << std::setw(15) << transaction.getFormattedAmount()
+                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << transaction.getBalance() << "\n";
+        };
+        snapshot->archive->forEach(printRow);
+        snapshot->journal->forEach(0, snapshot->journalLength, [&printRow](const std::shared_ptr<Transaction>& transaction) {
+            printRow(*transaction);
+        });
     }
     
     std::cout << "══════════════════════════════════════════════════════════════\n";
@@ -396,10 +436,7 @@ std::shared_ptr<Loan> BankingSystem::applyForLoan(std::shared_ptr<Customer> cust
         return nullptr;
     }
     
-    auto loan = std::make_shared<Loan>(customer->getUserId(), loanType, amount, termMonths, customer->getCreditScore());
-    loans.push_back(loan);
-    customer->addLoan(loan);
-    totalLoans += amount;
+    auto loan = requestLoan(customer, loanType, Money::fromDouble(amount), termMonths);
     
     std::cout << "Loan application submitted successfully!\n";
     std::cout << "Loan ID: " << loan->getLoanId() << "\n";
@@ -419,7 +456,7 @@ void BankingSystem::processLoanApplications() {
             pendingCount++;
             std::cout << "\nLoan ID: " << loan->getLoanId() << "\n";
             std::cout << "Customer ID: " << loan->getCustomerId() << "\n";
-            std::cout << "Amount: $" << std::fixed << std::setprecision(2) << loan->getAmount() << "\n";
+            std::cout << "Amount: $" << loan->getAmountMoney() << "\n";
             std::cout << "Type: " << loan->getLoanType() << "\n";
             std::cout << "Credit Score: " << loan->getCreditScore() << "\n";
             
@@ -428,8 +465,13 @@ void BankingSystem::processLoanApplications() {
             std::cin >> choice;
             
             if (choice == 'y' || choice == 'Y') {
+                PostingScope posting(*this);
+                statistics.removeLoan(*loan);
                 loan->approve();
-                std::cout << "Loan approved!\n";
+                loan->disburse();
+                statistics.addLoan(*loan);
+                loanVersion.fetch_add(1);
+                std::cout << "Loan approved and disbursed!\n";
             } else {
                 std::cout << "Loan rejected.\n";
             }
@@ -454,6 +496,9 @@ void BankingSystem::viewLoanStatus(std::shared_ptr<Customer> customer) const {
     
     for (const auto& loan : customerLoans) {
         loan->displayInfo();
+        if (loan->getStatus() == "Active") {
+            loan->displaySchedule();
+        }
     }
 }
 
@@ -468,7 +513,8 @@ bool BankingSystem::makeLoanPayment(std::shared_ptr<Customer> customer) {
     for (size_t i = 0; i < customerLoans.size(); ++i) {
         std::cout << i + 1 << ". " << customerLoans[i]->getLoanId() 
                   << " (" << customerLoans[i]->getLoanType() << ") - $"
-                  << std::fixed << std::setprecision(2) << customerLoans[i]->getRemainingBalance() << "\n";
+                  << customerLoans[i]->getRemainingBalanceMoney() << " (payoff $"
+                  << customerLoans[i]->getPayoffAmount() << ")\n";
     }
     
     int choice;
@@ -486,9 +532,9 @@ bool BankingSystem::makeLoanPayment(std::shared_ptr<Customer> customer) {
         double amount;
         std::cin >> amount;
         
-        if (loan->makePayment(amount)) {
+        if (payLoan(loan->getLoanId(), Money::fromDouble(amount)) == OperationStatus::Success) {
             std::cout << "Payment successful! Remaining balance: $"
-                      << std::fixed << std::setprecision(2) << loan->getRemainingBalance() << "\n";
+                      << loan->getRemainingBalanceMoney() << " (payoff $" << loan->getPayoffAmount() << ")\n";
             return true;
         } else {
             std::cout << "Payment failed.\n";
@@ -505,7 +551,8 @@ void BankingSystem::displayAllLoans() const {
     std::cout << "                        ALL LOANS\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
     
-    if (loans.empty()) {
+    auto snapshot = pinSnapshot();
+    if (snapshot->loans.empty()) {
         std::cout << "No loans found.\n";
     } else {
         std::cout << std::setw(15) << "Loan ID" << std::setw(15) << "Customer ID" 
@@ -513,18 +560,177 @@ void BankingSystem::displayAllLoans() const {
                   << std::setw(15) << "Status\n";
         std::cout << std::string(75, '-') << "\n";
         
-        for (const auto& loan : loans) {
-            std::cout << std::setw(15) << loan->getLoanId()
-                      << std::setw(15) << loan->getCustomerId()
-                      << std::setw(15) << loan->getLoanType()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << loan->getAmount()
-                      << std::setw(15) << loan->getStatus() << "\n";
+        for (const auto& row : snapshot->loans) {
+            std::cout << std::setw(15) << row.loan->getLoanId()
+                      << std::setw(15) << row.loan->getCustomerId()
+                      << std::setw(15) << row.loan->getLoanType()
+                      << std::setw(15) << "$" << row.loan->getAmountMoney()
+                      << std::setw(15) << row.status << "\n";
         }
     }
     
     std::cout << "══════════════════════════════════════════════════════════════\n";
 }
 
+std::shared_ptr<Loan> BankingSystem::findLoan(const std::string& loanId) {
+    auto it = loanIndex.find(loanId);
+    return it != loanIndex.end() ? it->second : nullptr;
+}
+
+std::vector<LoanGroupStats> BankingSystem::analyzeLoans(LoanDimension dimension) {
+    return getLoanAnalytics()->aggregate(dimension, getBatchPool());
+}
+
+void BankingSystem::displayLoanPortfolio() {
+    auto analytics = getLoanAnalytics();
+    
+    std::cout << "\n══════════════════════════════════════════════════════════════\n";
+    std::cout << "                    LOAN PORTFOLIO ANALYTICS\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+    std::cout << "Loans analyzed: " << analytics->size() << "\n";
+    
+    const LoanDimension dimensions[] = {LoanDimension::LoanType, LoanDimension::Status,
+                                        LoanDimension::CreditBand, LoanDimension::TermBucket};
+    for (LoanDimension dimension : dimensions) {
+        std::cout << "\nBy " << LoanAnalytics::dimensionName(dimension) << ":\n";
+        std::cout << std::left << std::setw(18) << "Group" << std::right << std::setw(8) << "Count"
+                  << std::setw(16) << "Principal" << std::setw(16) << "Remaining"
+                  << std::setw(8) << "Rate" << std::setw(14) << "Inflow/mo" << "\n";
+        std::cout << std::string(80, '-') << "\n";
+        for (const auto& group : analytics->aggregate(dimension, getBatchPool())) {
+            std::cout << std::left << std::setw(18) << group.label << std::right
+                      << std::setw(8) << group.count
+                      << std::setw(16) << group.principal.toString()
+                      << std::setw(16) << group.remaining.toString()
+                      << std::setw(7) << std::fixed << std::setprecision(2) << group.weightedRate << "%"
+                      << std::setw(14) << group.monthlyInflow.toString() << "\n";
+        }
+    }
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+}
+
+// Non-interactive transaction API
+OperationStatus BankingSystem::deposit(const std::string& accountNumber, Money amount) {
+    LatencyTimer timer(latency, LatencyOperation::Deposit);
+    TraceSpan span("deposit", "ledger");
+    if (!validateAmount(amount)) {
+        return OperationStatus::InvalidAmount;
+    }
+    auto account = findAccount(accountNumber);
+    if (!account) {
+        return OperationStatus::AccountNotFound;
+    }
+    if (admission.admit(account->getCustomerId()) != AdmissionResult::Admitted) {
+        return OperationStatus::Throttled;
+    }
+    PostingScope posting(*this);
+    if (!account->deposit(amount)) {
+        return OperationStatus::Declined;
+    }
+    return OperationStatus::Success;
+}
+
+OperationStatus BankingSystem::withdraw(const std::string& accountNumber, Money amount) {
+    LatencyTimer timer(latency, LatencyOperation::Withdraw);
+    TraceSpan span("withdraw", "ledger");
+    if (!validateAmount(amount)) {
+        return OperationStatus::InvalidAmount;
+    }
+    auto account = findAccount(accountNumber);
+    if (!account) {
+        return OperationStatus::AccountNotFound;
+    }
+    if (admission.admit(account->getCustomerId()) != AdmissionResult::Admitted) {
+        return OperationStatus::Throttled;
+    }
+    PostingScope posting(*this);
+    if (!account->withdraw(amount)) {
+        return OperationStatus::Declined;
+    }
+    return OperationStatus::Success;
+}
+
+OperationStatus BankingSystem::transfer(const std::string& sourceAccountNumber, 
+                                        const std::string& targetAccountNumber, Money amount) {
+    LatencyTimer timer(latency, LatencyOperation::Transfer);
+    TraceSpan span("transfer", "ledger");
+    if (!validateAmount(amount)) {
+        return OperationStatus::InvalidAmount;
+    }
+    auto sourceAccount = findAccount(sourceAccountNumber);
+    auto targetAccount = findAccount(targetAccountNumber);
+    if (!sourceAccount || !targetAccount) {
+        return OperationStatus::AccountNotFound;
+    }
+    if (admission.admit(sourceAccount->getCustomerId()) != AdmissionResult::Admitted) {
+        return OperationStatus::Throttled;
+    }
+    PostingScope posting(*this);
+    if (sourceAccount == targetAccount || !sourceAccount->transfer(*targetAccount, amount)) {
+        return OperationStatus::Declined;
+    }
+    return OperationStatus::Success;
+}
+
+OperationStatus BankingSystem::payLoan(const std::string& loanId, Money amount) {
+    LatencyTimer timer(latency, LatencyOperation::LoanPayment);
+    TraceSpan span("payLoan", "ledger");
+    if (!validateAmount(amount)) {
+        return OperationStatus::InvalidAmount;
+    }
+    auto loan = findLoan(loanId);
+    if (!loan) {
+        return OperationStatus::LoanNotFound;
+    }
+    if (admission.admit(loan->getCustomerId()) != AdmissionResult::Admitted) {
+        return OperationStatus::Throttled;
+    }
+    PostingScope posting(*this);
+    statistics.removeLoan(*loan);
+    bool paid = loan->makePayment(amount);
+    statistics.addLoan(*loan);
+    loanVersion.fetch_add(1);
+    return paid ? OperationStatus::Success : OperationStatus::Declined;
+}
+
+std::shared_ptr<Loan> BankingSystem::requestLoan(std::shared_ptr<Customer> customer, const std::string& loanType, 
+                                                 Money amount, int termMonths) {
+    PostingScope posting(*this);
+    auto loan = std::make_shared<Loan>(customer->getUserId(), loanType, amount, termMonths, customer->getCreditScore());
+    loan->setPaymentLog(&loanPayments);
+    {
+        std::lock_guard<std::mutex> guard(loansMutex);
+        loans.push_back(loan);
+    }
+    loanIndex[loan->getLoanId()] = loan;
+    customer->addLoan(loan);
+    statistics.addLoan(*loan);
+    loanVersion.fetch_add(1);
+    return loan;
+}
+
+std::string BankingSystem::statusToString(OperationStatus status) {
+    switch (status) {
+        case OperationStatus::Success: return "Success";
+        case OperationStatus::InvalidAmount: return "Invalid amount";
+        case OperationStatus::AccountNotFound: return "Account not found";
+        case OperationStatus::LoanNotFound: return "Loan not found";
+        case OperationStatus::NotAuthorized: return "Not authorized";
+        case OperationStatus::Declined: return "Declined";
+        case OperationStatus::Throttled: return "Throttled";
+    }
+    return "Unknown";
+}
+
+// Admission control
+AdmissionController& BankingSystem::getAdmissionController() {
+    return admission;
+}
+
+const AdmissionController& BankingSystem::getAdmissionController() const {
+    return admission;
+}
+
 // Account operations
 void BankingSystem::displayAccountBalance(std::shared_ptr<Customer> customer) const {
     customer->displayAccountSummary();
@@ -542,11 +748,11 @@ void BankingSystem::changePassword(std::shared_ptr<Customer> customer) {
 void BankingSystem::calculateInterest() {
     std::cout << "\nCalculating interest for all accounts...\n";
     for (auto& account : accounts) {
-        if (account->isActive() && account->getBalance() > 0) {
-            double interest = account->calculateInterest();
-            if (interest > 0) {
+        if (account->isActive() && account->getBalanceCents() > 0) {
+            Money interest = account->calculateInterest();
+            if (interest > Money()) {
                 std::cout << "Account " << account->getAccountNumber() 
-                          << ": Interest = $" << std::fixed << std::setprecision(2) << interest << "\n";
+                          << ": Interest = $" << interest << "\n";
             }
         }
     }
@@ -555,12 +761,281 @@ void BankingSystem::calculateInterest() {
 
 void BankingSystem::applyInterestToAllAccounts() {
     std::cout << "\nApplying interest to all accounts...\n";
-    for (auto& account : accounts) {
-        if (account->isActive() && account->getBalance() > 0) {
-            account->applyInterest();
+    BatchJobReport report = accrueInterest();
+    std::cout << "Interest applied to " << report.itemsProcessed << " accounts in "
+              << std::fixed << std::setprecision(3) << report.seconds << "s.\n";
+}
+
+// Batch processing
+std::vector<BatchJobReport> BankingSystem::runEndOfDayBatch() {
+    // Limit windows are not reset here: the rollover at midnight starts the new periods.
+    // Each job posts chunk by chunk, so snapshots taken meanwhile only wait for one chunk
+    std::vector<BatchJobReport> reports;
+    
+    reports.push_back(accrueInterest());
+    
+    reports.push_back(rescoreCustomers());
+    
+    reports.push_back(rebuildAmortizationSchedules());
+    
+    return reports;
+}
+
+BatchJobReport BankingSystem::resetPeriodCounters(bool monthly) {
+    // Runs off the rollover thread while the menus and the server keep opening
+    // accounts, so it walks a copy of the list; an account opened after the
+    // copy starts out in the new period anyway
+    std::vector<std::shared_ptr<Account>> current = copyAccountList();
+    return runBatchJob(monthly ? "Day and month rollover" : "Day rollover", current.size(),
+                       [this, &current, monthly](size_t begin, size_t end) {
+        PostingScope posting(*this);
+        for (size_t i = begin; i < end; ++i) {
+            current[i]->resetDailyLimits();
+            if (monthly) {
+                current[i]->resetMonthlyLimits();
+                if (auto savings = dynamic_cast<SavingsAccount*>(current[i].get())) {
+                    savings->resetMonthlyTransactions();
+                }
+            }
+        }
+    });
+}
+
+bool BankingSystem::rolloverPeriods() {
+    PeriodClock& clock = PeriodClock::shared();
+    long long month = clock.getMonthNumber();
+    if (!clock.advance()) {
+        return false;
+    }
+    resetPeriodCounters(clock.getMonthNumber() != month);
+    return true;
+}
+
+void BankingSystem::startRolloverScheduler() {
+    if (rolloverThread.joinable()) {
+        return;
+    }
+    rolloverStopping = false;
+    rolloverThread = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(rolloverMutex);
+        while (!rolloverStopping) {
+            // Wake just after midnight, and at least once a minute in case the wall clock jumps
+            long long seconds = std::min<long long>(PeriodClock::secondsUntilMidnight() + 1, 60);
+            rolloverWake.wait_for(lock, std::chrono::seconds(seconds), [this]() { return rolloverStopping; });
+            if (rolloverStopping) {
+                break;
+            }
+            lock.unlock();
+            rolloverPeriods();
+            lock.lock();
         }
+    });
+}
+
+void BankingSystem::stopRolloverScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(rolloverMutex);
+        rolloverStopping = true;
     }
-    std::cout << "Interest applied to all accounts.\n";
+    rolloverWake.notify_all();
+    if (rolloverThread.joinable()) {
+        rolloverThread.join();
+    }
+}
+
+BatchJobReport BankingSystem::rescoreCustomers() {
+    std::atomic<size_t> tierChanges(0);
+    std::vector<std::shared_ptr<Customer>> current = copyCustomerList();
+    
+    BatchJobReport report = runBatchJob("Credit scores and tiers", current.size(),
+                                        [this, &current, &tierChanges](size_t begin, size_t end) {
+        // Read the cached aggregates into columns, score them in one tight pass, then write back
+        size_t count = end - begin;
+        std::vector<Money> balances(count);
+        std::vector<unsigned char> activeLoans(count);
+        for (size_t i = 0; i < count; ++i) {
+            const Customer& customer = *current[begin + i];
+            balances[i] = customer.getTotalBalance();
+            activeLoans[i] = customer.hasActiveLoans();
+        }
+        
+        std::vector<double> scores(count);
+        std::vector<const char*> tiers(count);
+        for (size_t i = 0; i < count; ++i) {
+            scores[i] = Customer::calculateCreditScore(balances[i], activeLoans[i] != 0);
+            tiers[i] = Customer::calculateCustomerType(balances[i], scores[i]);
+        }
+        
+        PostingScope posting(*this); // Only the write-back holds snapshots off
+        size_t changed = 0;
+        for (size_t i = 0; i < count; ++i) {
+            Customer& customer = *current[begin + i];
+            customer.setCreditScore(scores[i]);
+            if (customer.getCustomerType() != tiers[i]) {
+                customer.setCustomerType(tiers[i]);
+                changed++;
+            }
+        }
+        tierChanges.fetch_add(changed, std::memory_order_relaxed);
+    });
+    
+    report.itemsChanged = tierChanges.load();
+    return report;
+}
+
+BatchJobReport BankingSystem::generateStatements(int year, int month, const std::string& baseDirectory) {
+    // Render from a pinned snapshot: the rows keep every account alive, and
+    // postings can carry on while the files are written
+    auto snapshot = pinSnapshot();
+    StatementGenerator generator(year, month, baseDirectory, snapshot->takenAt);
+    if (!generator.prepareDirectory()) {
+        return BatchJobReport{"Monthly statements", 0, 0.0};
+    }
+    
+    std::atomic<size_t> written(0);
+    std::atomic<size_t> withActivity(0);
+    BatchJobReport report = runBatchJob("Monthly statements", snapshot->accounts.size(),
+                                        [&](size_t begin, size_t end) {
+        StatementScratch scratch;
+        size_t blockWritten = 0, blockActive = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const Account& account = *snapshot->accounts[i].account;
+            if (generator.writeStatement(account, snapshot->balances[i], scratch)) {
+                blockWritten++;
+                blockActive += scratch.entries.empty() ? 0 : 1;
+            }
+        }
+        written.fetch_add(blockWritten, std::memory_order_relaxed);
+        withActivity.fetch_add(blockActive, std::memory_order_relaxed);
+    });
+    
+    report.itemsProcessed = written.load();
+    report.itemsChanged = withActivity.load();
+    return report;
+}
+
+void BankingSystem::processMonthlyStatements() {
+    int year = 0, month = 0;
+    StatementGenerator::previousMonth(year, month);
+    
+    std::string period;
+    std::cout << "\nStatement month (YYYY-MM, or . for last month): ";
+    std::cin >> period;
+    if (period != "." && !StatementGenerator::parsePeriod(period, year, month)) {
+        std::cout << "Invalid month.\n";
+        return;
+    }
+    
+    std::cout << "\n══════════════════════════════════════════════════════════════\n";
+    std::cout << "                  MONTHLY STATEMENT RUN\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+    std::cout << "Worker threads: " << getBatchPool().getThreadCount() << "\n";
+    
+    BatchJobReport report = generateStatements(year, month);
+    std::cout << "Statements written: " << report.itemsProcessed << " of " << accounts.size() << "\n";
+    std::cout << "With activity: " << report.itemsChanged << "\n";
+    std::cout << "Time: " << std::fixed << std::setprecision(3) << report.seconds << "s\n";
+    std::cout << "Output: " << StatementGenerator(year, month, "statements", "").getDirectory() << "/\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+}
+
+BatchJobReport BankingSystem::rebuildAmortizationSchedules() {
+    // Schedules only read loan fields, so loans can be rebuilt in any order
+    std::vector<std::shared_ptr<Loan>> current = copyLoanList();
+    return runBatchJob("Amortization schedules", current.size(), [&current](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (current[i]->getStatus() != "Paid") {
+                current[i]->refreshSchedule();
+            }
+        }
+    });
+}
+
+void BankingSystem::processEndOfDay() {
+    std::cout << "\n══════════════════════════════════════════════════════════════\n";
+    std::cout << "                    END-OF-DAY PROCESSING\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+    std::cout << "Worker threads: " << getBatchPool().getThreadCount() << "\n";
+    std::cout << "Limit rollover: automatic at midnight\n\n";
+    
+    double totalSeconds = 0.0;
+    for (const auto& report : runEndOfDayBatch()) {
+        std::cout << std::left << std::setw(24) << report.jobName << std::right
+                  << std::setw(10) << report.itemsProcessed << " items "
+                  << std::fixed << std::setprecision(3) << std::setw(10) << report.seconds << "s";
+        if (report.itemsChanged > 0) {
+            std::cout << "  (" << report.itemsChanged << " changed)";
+        }
+        std::cout << "\n";
+        totalSeconds += report.seconds;
+    }
+    std::cout << "\nBatch completed in " << std::fixed << std::setprecision(3) << totalSeconds << "s\n";
+    std::cout << "Statistics audit: " << (auditStatistics() ? "OK" : "MISMATCH") << "\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+}
+
+std::shared_ptr<const LoanAnalytics> BankingSystem::getLoanAnalytics() {
+    // The version is read before pinning, so the snapshot holds at least every loan change it counts
+    uint64_t version = loanVersion.load();
+    auto cached = std::atomic_load(&loanAnalytics);
+    if (!cached || cached->getVersion() != version) {
+        auto snapshot = pinSnapshot();
+        cached = std::make_shared<LoanAnalytics>(*snapshot, version, getBatchPool());
+        std::atomic_store(&loanAnalytics, cached);
+    }
+    return cached;
+}
+
+BatchJobReport BankingSystem::accrueInterest() {
+    // Every posting in the run shares one timestamp
+    const std::string date = getCurrentDateTime();
+    // Accounts opened during the run are left for the next one
+    std::vector<std::shared_ptr<Account>> current = copyAccountList();
+    
+    // Each chunk is its own posting; a snapshot taken mid-run waits for one chunk, not the batch
+    return runBatchJob("Interest", current.size(), [this, &current, &date](size_t begin, size_t end) {
+        // Gather eligible accounts into contiguous columns for the kernel
+        std::vector<size_t> eligible;
+        std::vector<int64_t> balances;
+        std::vector<int64_t> rates;
+        std::vector<int32_t> periods;
+        eligible.reserve(end - begin);
+        balances.reserve(end - begin);
+        rates.reserve(end - begin);
+        periods.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            const Account& account = *current[i];
+            long long balance = account.getBalanceCents();
+            if (account.isActive() && balance > 0) {
+                eligible.push_back(i);
+                balances.push_back(balance);
+                rates.push_back(Money::rateToMicros(account.getInterestRate()));
+                periods.push_back(account.getInterestPeriodsPerYear());
+            }
+        }
+        
+        std::vector<int64_t> interest(eligible.size());
+        InterestKernel::accrue(balances.data(), rates.data(), periods.data(), interest.data(), eligible.size());
+        
+        PostingScope posting(*this);
+        std::vector<std::shared_ptr<Transaction>> postings;
+        postings.reserve(eligible.size());
+        for (size_t k = 0; k < eligible.size(); ++k) {
+            if (interest[k] > 0) {
+                postings.push_back(current[eligible[k]]->postInterest(Money::fromCents(interest[k]), date));
+            }
+        }
+        transactions.appendBatch(postings);
+    });
+}
+
+const BatchProgress& BankingSystem::getBatchProgress() const {
+    return batchProgress;
+}
+
+std::string BankingSystem::getBatchJobName() const {
+    const char* name = batchJobName.load();
+    return name ? name : "";
 }
 
 // System operations
@@ -627,79 +1102,494 @@ void BankingSystem::backupDatabase() {
 }
 
 void BankingSystem::displaySystemStatistics() const {
+    LedgerTotals totals = getStatistics();
     std::cout << "\n══════════════════════════════════════════════════════════════\n";
     std::cout << "                    SYSTEM STATISTICS\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
-    std::cout << "Total Customers: " << totalCustomers << "\n";
-    std::cout << "Total Accounts: " << totalAccounts << "\n";
-    std::cout << "Total Transactions: " << totalTransactions << "\n";
-    std::cout << "Total Loans: " << loans.size() << "\n";
-    std::cout << "Total Deposits: $" << std::fixed << std::setprecision(2) << totalDeposits << "\n";
-    std::cout << "Total Withdrawals: $" << std::fixed << std::setprecision(2) << totalWithdrawals << "\n";
-    std::cout << "Total Loans Amount: $" << std::fixed << std::setprecision(2) << totalLoans << "\n";
-    
-    double totalBalance = 0.0;
-    for (const auto& account : accounts) {
-        totalBalance += account->getBalance();
+    std::cout << "Total Customers: " << totals.customers << "\n";
+    std::cout << "Total Accounts: " << totals.accounts << "\n";
+    std::cout << "Total Transactions: " << totals.transactions << "\n";
+    std::cout << "Total Loans: " << totals.loans << "\n";
+    std::cout << "Total Deposits: $" << totals.deposits << "\n";
+    std::cout << "Total Withdrawals: $" << totals.withdrawals << "\n";
+    std::cout << "Total Loans Amount: $" << totals.loanAmount << "\n";
+    std::cout << "Total Bank Balance: $" << totals.balance << "\n";
+    for (int i = 0; i < LedgerTotals::kLoanStatusCount; ++i) {
+        const LoanStatusTotals& bucket = totals.loansByStatus[i];
+        if (bucket.count > 0) {
+            std::cout << "  " << LedgerStatistics::loanStatusName(i) << " loans: " << bucket.count
+                      << " ($" << bucket.amount << ", outstanding $" << bucket.outstanding << ")\n";
+        }
+    }
+    
+    auto admissionStats = admission.getStatistics();
+    std::cout << "Admitted Requests: " << admissionStats.admitted << "\n";
+    std::cout << "Throttled (customer limit): " << admissionStats.throttledCustomer << "\n";
+    std::cout << "Throttled (system limit): " << admissionStats.throttledGlobal << "\n";
+    for (const auto& entry : admissionStats.topThrottled) {
+        std::cout << "  Customer " << entry.first << ": " << entry.second << " shed\n";
+    }
+    
+    // Latencies in microseconds
+    std::cout << "\nLatency (us):\n";
+    std::cout << std::left << std::setw(14) << "Operation" << std::right << std::setw(10) << "Count"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+              << std::setw(12) << "max" << "\n";
+    std::cout << std::string(66, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (int op = 0; op < LatencyRecorder::kOperationCount; ++op) {
+        auto operation = static_cast<LatencyOperation>(op);
+        LatencyHistogram histogram = latency.getHistogram(operation);
+        if (histogram.getCount() == 0) {
+            continue;
+        }
+        std::cout << std::left << std::setw(14) << LatencyRecorder::operationName(operation) << std::right
+                  << std::setw(10) << histogram.getCount()
+                  << std::setw(10) << histogram.percentile(50.0) / 1000.0
+                  << std::setw(10) << histogram.percentile(99.0) / 1000.0
+                  << std::setw(10) << histogram.percentile(99.9) / 1000.0
+                  << std::setw(12) << histogram.getMax() / 1000.0 << "\n";
+    }
+    
+    // Where the last load and save spent their time
+    for (const PersistenceProfile& profile : {getLoadProfile(), getSaveProfile()}) {
+        if (!profile.files.empty()) {
+            std::cout << "\n";
+            profile.print(std::cout);
+        }
     }
-    std::cout << "Total Bank Balance: $" << std::fixed << std::setprecision(2) << totalBalance << "\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
 }
 
+LatencyRecorder& BankingSystem::getLatencyRecorder() {
+    return latency;
+}
+
+std::string BankingSystem::dumpLatency() const {
+    std::ostringstream oss;
+    for (int op = 0; op < LatencyRecorder::kOperationCount; ++op) {
+        auto operation = static_cast<LatencyOperation>(op);
+        LatencyHistogram histogram = latency.getHistogram(operation);
+        if (op > 0) {
+            oss << " ";
+        }
+        oss << LatencyRecorder::operationKey(operation) << ":" << histogram.getCount() << ":"
+            << histogram.percentile(50.0) << ":" << histogram.percentile(99.0) << ":"
+            << histogram.percentile(99.9) << ":" << histogram.getMax();
+    }
+    return oss.str();
+}
+
 void BankingSystem::loadData() {
-    loadCustomersFromFile();
-    loadAccountsFromFile();
-    loadTransactionsFromFile();
-    loadLoansFromFile();
-    updateSystemStatistics();
+    LatencyTimer timer(latency, LatencyOperation::LoadData);
+    TraceSpan span("loadData", "persistence");
+    PostingScope posting(*this);
+    auto start = std::chrono::steady_clock::now();
+    
+    PersistenceProfile profile;
+    profile.operation = "Load";
+    profile.files.resize(5);
+    profile.files[0].fileName = customersFile;
+    profile.files[1].fileName = accountsFile;
+    profile.files[2].fileName = transactionsFile;
+    profile.files[3].fileName = loansFile;
+    profile.files[4].fileName = "(lookup indexes)";
+    loadCustomersFromFile(profile.files[0]);
+    loadAccountsFromFile(profile.files[1]);
+    loadTransactionsFromFile(profile.files[2]);
+    loadLoansFromFile(profile.files[3]);
+    
+    savedJournalSize.store(transactions.size());
+    
+    PhaseTimer indexTimer(profile.files[4]);
+    {
+        TraceSpan indexSpan("rebuildIndexes", "persistence");
+        rebuildIndexes();
+    }
+    profile.files[4].records = customers.size() + accounts.size() + loans.size();
+    indexTimer.lap(PersistencePhase::Index);
+    
+    profile.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    profile.finishedAt = getCurrentDateTime();
+    std::lock_guard<std::mutex> guard(profileMutex);
+    loadProfile = profile;
 }
 
 void BankingSystem::saveData() {
-    saveCustomersToFile();
-    saveAccountsToFile();
-    saveTransactionsToFile();
-    saveLoansToFile();
+    LatencyTimer timer(latency, LatencyOperation::SaveData);
+    TraceSpan span("saveData", "persistence");
+    auto start = std::chrono::steady_clock::now();
+    
+    PersistenceProfile profile;
+    profile.operation = "Save";
+    profile.files.resize(4);
+    profile.files[0].fileName = customersFile;
+    profile.files[1].fileName = accountsFile;
+    profile.files[2].fileName = transactionsFile;
+    profile.files[3].fileName = loansFile;
+    size_t journalSize = transactions.size();
+    saveCustomersToFile(profile.files[0]);
+    saveAccountsToFile(profile.files[1]);
+    bool journalSaved = saveTransactionsToFile(profile.files[2]);
+    saveLoansToFile(profile.files[3]);
+    if (journalSaved) {
+        savedJournalSize.store(journalSize);
+    }
+    {
+        TraceSpan paymentsSpan("saveLoanPayments", "persistence");
+        loanPayments.save();
+    }
+    
+    profile.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    profile.finishedAt = getCurrentDateTime();
+    std::lock_guard<std::mutex> guard(profileMutex);
+    saveProfile = profile;
+}
+
+MemoryReport BankingSystem::measureMemory() const {
+    MemoryReport report;
+    std::lock_guard<std::mutex> builder(snapshotMutex);
+    snapshotBarrier.store(true);
+    while (postingsInFlight.load() != 0) {
+        std::this_thread::yield();
+    }
+    
+    for (const auto& customer : customers) {
+        customer->addMemoryUsage(report);
+    }
+    for (const auto& account : accounts) {
+        account->addMemoryUsage(report);
+    }
+    for (const auto& loan : loans) {
+        loan->addMemoryUsage(report);
+    }
+    transactions.addMemoryUsage(report);
+    transactionArchive.addMemoryUsage(report);
+    loanPayments.addMemoryUsage(report);
+    
+    report.addVector(MemorySubsystem::Indexes, customers);
+    report.addVector(MemorySubsystem::Indexes, accounts);
+    report.addVector(MemorySubsystem::Indexes, loans);
+    report.addHashMap(MemorySubsystem::Indexes, customersByAccountNumber);
+    report.addHashMap(MemorySubsystem::Indexes, customersById);
+    report.addHashMap(MemorySubsystem::Indexes, accountIndex);
+    report.addHashMap(MemorySubsystem::Indexes, loanIndex);
+    
+    snapshotBarrier.store(false);
+    return report;
+}
+
+void BankingSystem::displayMemoryUsage() const {
+    auto start = std::chrono::steady_clock::now();
+    MemoryReport report = measureMemory();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << "\n══════════════════════════════════════════════════════════════\n";
+    std::cout << "                    MEMORY USAGE\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+    report.print(std::cout);
+    std::cout << "Measured in " << std::fixed << std::setprecision(3) << seconds << "s\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+}
+
+std::vector<std::string> BankingSystem::getDataFiles() const {
+    return {customersFile, accountsFile, transactionsFile, loansFile, loanPaymentsFile};
+}
+
+PersistenceProfile BankingSystem::getLoadProfile() const {
+    std::lock_guard<std::mutex> guard(profileMutex);
+    return loadProfile;
+}
+
+PersistenceProfile BankingSystem::getSaveProfile() const {
+    std::lock_guard<std::mutex> guard(profileMutex);
+    return saveProfile;
 }
 
 void BankingSystem::clearData() {
-    customers.clear();
-    accounts.clear();
+    PostingScope posting(*this);
+    for (const auto& account : accounts) {
+        account->setStatistics(nullptr);
+    }
+    {
+        std::lock_guard<std::mutex> guard(customersMutex);
+        customers.clear();
+    }
+    {
+        std::lock_guard<std::mutex> guard(accountsMutex);
+        accounts.clear();
+    }
     transactions.clear();
-    loans.clear();
-    totalCustomers = totalAccounts = totalTransactions = 0;
-    totalDeposits = totalWithdrawals = totalLoans = 0.0;
+    transactionArchive.clear();
+    {
+        std::lock_guard<std::mutex> guard(loansMutex);
+        loans.clear();
+    }
+    customersByAccountNumber.clear();
+    customersById.clear();
+    accountIndex.clear();
+    loanIndex.clear();
+    loanPayments.clear();
+    std::atomic_store(&loanAnalytics, std::shared_ptr<const LoanAnalytics>());
+    loanVersion.fetch_add(1);
+    statistics.reset();
+    savedJournalSize.store(0);
 }
 
-// Utility methods
-void BankingSystem::updateSystemStatistics() {
-    totalCustomers = customers.size();
-    totalAccounts = accounts.size();
-    totalTransactions = transactions.size();
-    
-    totalDeposits = 0.0;
-    totalWithdrawals = 0.0;
-    totalLoans = 0.0;
-    
-    for (const auto& transaction : transactions) {
-        if (transaction->getAmount() > 0) {
-            totalDeposits += transaction->getAmount();
+// Read snapshots
+std::shared_ptr<const LedgerSnapshot> BankingSystem::pinSnapshot() const {
+    auto cached = std::atomic_load(&currentSnapshot);
+    if (cached && cached->epoch == ledgerEpoch.load()) {
+        return cached;
+    }
+    
+    std::lock_guard<std::mutex> builder(snapshotMutex);
+    cached = std::atomic_load(&currentSnapshot);
+    if (cached && cached->epoch == ledgerEpoch.load()) {
+        return cached;
+    }
+    
+    // Optimistic copy: every row at the same cut if no posting was in flight or completed meanwhile
+    std::shared_ptr<LedgerSnapshot> snapshot;
+    uint64_t epochBefore = ledgerEpoch.load();
+    if (postingsInFlight.load() == 0) {
+        snapshot = copyLedgerRows();
+        copyLedgerCounters(*snapshot);
+        if (postingsInFlight.load() != 0 || ledgerEpoch.load() != epochBefore) {
+            snapshot.reset();
+        }
+    }
+    
+    // Under steady write load the rows are copied while postings carry on,
+    // and new postings are held back only for the handful of counter reads
+    if (!snapshot) {
+        snapshot = copyLedgerRows();
+        snapshotBarrier.store(true);
+        while (postingsInFlight.load() != 0) {
+            std::this_thread::yield();
+        }
+        epochBefore = ledgerEpoch.load();
+        copyLedgerCounters(*snapshot);
+        snapshotBarrier.store(false);
+    }
+    
+    snapshot->epoch = epochBefore;
+    snapshot->takenAt = getCurrentDateTime();
+    std::shared_ptr<const LedgerSnapshot> published = snapshot;
+    std::atomic_store(&currentSnapshot, published);
+    return published;
+}
+
+BankingSystem::PostingScope::PostingScope(const BankingSystem& bank) : bank(bank) {
+    bank.beginPosting();
+}
+
+BankingSystem::PostingScope::~PostingScope() {
+    bank.endPosting();
+}
+
+ThreadPool& BankingSystem::getBatchPool() {
+    std::call_once(batchPoolCreated, [this]() {
+        batchPool = std::make_unique<ThreadPool>();
+    });
+    return *batchPool;
+}
+
+BatchJobReport BankingSystem::runBatchJob(const char* jobName, size_t itemCount,
+                                          const std::function<void(size_t, size_t)>& body) {
+    std::lock_guard<std::mutex> running(batchMutex);
+    ThreadPool& pool = getBatchPool();
+    
+    // Enough chunks per worker for stealing to even out uneven work
+    size_t grain = std::max<size_t>(256, itemCount / (pool.getThreadCount() * 16));
+    
+    batchJobName = jobName;
+    TraceSpan span(jobName, "batch");
+    auto start = std::chrono::steady_clock::now();
+    if (Tracer::shared().isEnabled()) {
+        // One span per chunk shows how the work spread over the workers
+        pool.parallelFor(0, itemCount, grain, [jobName, &body](size_t begin, size_t end) {
+            TraceSpan chunkSpan(jobName, "batch chunk");
+            body(begin, end);
+        }, &batchProgress);
+    } else {
+        pool.parallelFor(0, itemCount, grain, body, &batchProgress);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    batchJobName = nullptr;
+    
+    return BatchJobReport{jobName, itemCount, seconds};
+}
+
+void BankingSystem::beginPosting() const {
+    while (true) {
+        while (snapshotBarrier.load()) {
+            std::this_thread::yield();
+        }
+        postingsInFlight.fetch_add(1);
+        if (!snapshotBarrier.load()) {
+            return;
+        }
+        postingsInFlight.fetch_sub(1); // A snapshot copy started; wait for it
+    }
+}
+
+void BankingSystem::endPosting() const {
+    ledgerEpoch.fetch_add(1);
+    postingsInFlight.fetch_sub(1);
+}
+
+std::shared_ptr<LedgerSnapshot> BankingSystem::copyLedgerRows() const {
+    // Each row is read through its own synchronized fields, so the lists can
+    // be walked while accounts and loans keep posting
+    auto snapshot = std::make_shared<LedgerSnapshot>();
+    auto accountList = copyAccountList();
+    snapshot->accounts.reserve(accountList.size());
+    snapshot->balances.reserve(accountList.size());
+    for (const auto& account : accountList) {
+        snapshot->accounts.push_back({account, account->isActive()});
+        snapshot->balances.push_back(account->getBalanceMoney());
+    }
+    auto loanList = copyLoanList();
+    snapshot->loans.resize(loanList.size());
+    for (size_t i = 0; i < loanList.size(); ++i) {
+        snapshot->loans[i].loan = loanList[i];
+        loanList[i]->getState(snapshot->loans[i].status, snapshot->loans[i].remainingBalance);
+    }
+    snapshot->archive = &transactionArchive;
+    snapshot->journal = &transactions;
+    return snapshot;
+}
+
+void BankingSystem::copyLedgerCounters(LedgerSnapshot& snapshot) const {
+    snapshot.archiveLength = transactionArchive.size();
+    snapshot.journalLength = transactions.size();
+    snapshot.totals = readTotals();
+    snapshot.customerCount = snapshot.totals.customers;
+}
+
+std::vector<std::shared_ptr<Customer>> BankingSystem::copyCustomerList() const {
+    std::lock_guard<std::mutex> guard(customersMutex);
+    return customers;
+}
+
+std::vector<std::shared_ptr<Account>> BankingSystem::copyAccountList() const {
+    std::lock_guard<std::mutex> guard(accountsMutex);
+    return accounts;
+}
+
+std::vector<std::shared_ptr<Loan>> BankingSystem::copyLoanList() const {
+    std::lock_guard<std::mutex> guard(loansMutex);
+    return loans;
+}
+
+LedgerTotals BankingSystem::readTotals() const {
+    LedgerTotals totals = statistics.getTotals();
+    {
+        std::lock_guard<std::mutex> guard(customersMutex);
+        totals.customers = customers.size();
+    }
+    {
+        std::lock_guard<std::mutex> guard(accountsMutex);
+        totals.accounts = accounts.size();
+    }
+    return totals;
+}
+
+// Statistics
+LedgerTotals BankingSystem::getStatistics() const {
+    // Optimistic read: the totals are a consistent cut if no posting overlapped it
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        uint64_t epochBefore = ledgerEpoch.load();
+        if (postingsInFlight.load() == 0) {
+            LedgerTotals totals = readTotals();
+            if (postingsInFlight.load() == 0 && ledgerEpoch.load() == epochBefore) {
+                return totals;
+            }
+        }
+        std::this_thread::yield();
+    }
+    
+    // Under steady write load, hold new postings back just for the read
+    std::lock_guard<std::mutex> builder(snapshotMutex);
+    snapshotBarrier.store(true);
+    while (postingsInFlight.load() != 0) {
+        std::this_thread::yield();
+    }
+    LedgerTotals totals = readTotals();
+    snapshotBarrier.store(false);
+    return totals;
+}
+
+LedgerTotals BankingSystem::recomputeStatistics() const {
+    LedgerTotals totals{};
+    totals.customers = customers.size();
+    totals.accounts = accounts.size();
+    totals.transactions = transactionArchive.size() + transactions.size();
+    
+    // Exact integer sums, so the totals reconcile to the cent with the journal
+    long long depositCents = transactionArchive.getCreditCents();
+    long long withdrawalCents = transactionArchive.getDebitCents();
+    transactions.forEach(0, transactions.size(), [&](const std::shared_ptr<Transaction>& transaction) {
+        long long cents = transaction->getAmountMoney().getCents();
+        if (cents > 0) {
+            depositCents += cents;
         } else {
-            totalWithdrawals += std::abs(transaction->getAmount());
+            withdrawalCents -= cents;
         }
+    });
+    totals.deposits = Money::fromCents(depositCents);
+    totals.withdrawals = Money::fromCents(withdrawalCents);
+    
+    long long balanceCents = 0;
+    for (const auto& account : accounts) {
+        balanceCents += account->getBalanceCents();
     }
+    totals.balance = Money::fromCents(balanceCents);
     
+    totals.loans = loans.size();
     for (const auto& loan : loans) {
-        totalLoans += loan->getAmount();
+        totals.loanAmount += loan->getAmountMoney();
+        int index = LedgerStatistics::loanStatusIndex(loan->getStatus());
+        if (index >= 0) {
+            totals.loansByStatus[index].count++;
+            totals.loansByStatus[index].amount += loan->getAmountMoney();
+            totals.loansByStatus[index].outstanding += loan->getRemainingBalanceMoney();
+        }
     }
+    return totals;
 }
 
+bool BankingSystem::auditStatistics() const {
+    // Hold postings back so the running totals and the scan see the same ledger
+    std::lock_guard<std::mutex> builder(snapshotMutex);
+    snapshotBarrier.store(true);
+    while (postingsInFlight.load() != 0) {
+        std::this_thread::yield();
+    }
+    bool matches = readTotals() == recomputeStatistics();
+    for (const auto& customer : customers) {
+        auto customerLoans = customer->getAllLoans();
+        int activeLoans = static_cast<int>(std::count_if(customerLoans.begin(), customerLoans.end(),
+            [](const std::shared_ptr<Loan>& loan) { return loan->getStatus() == "Active"; }));
+        matches = matches && customer->getTotalBalance() == customer->recomputeTotalBalance() &&
+                  customer->getActiveLoanCount() == activeLoans;
+    }
+    snapshotBarrier.store(false);
+    return matches;
+}
+
+// Utility methods
+
 std::string BankingSystem::generateReport() const {
     std::ostringstream oss;
+    auto snapshot = pinSnapshot();
     oss << "Banking System Report\n";
     oss << "Generated: " << getCurrentDateTime() << "\n";
-    oss << "Total Customers: " << totalCustomers << "\n";
-    oss << "Total Accounts: " << totalAccounts << "\n";
-    oss << "Total Transactions: " << totalTransactions << "\n";
+    oss << "Snapshot: epoch " << snapshot->epoch << " taken " << snapshot->takenAt << "\n";
+    oss << "Total Customers: " << snapshot->customerCount << "\n";
+    oss << "Total Accounts: " << snapshot->accounts.size() << "\n";
+    oss << "Total Transactions: " << snapshot->totals.transactions << "\n";
     return oss.str();
 }
 
@@ -711,6 +1601,10 @@ bool BankingSystem::validateAmount(double amount) const {
     return amount > 0 && amount <= 1000000.0; // Max $1M per transaction
 }
 
+bool BankingSystem::validateAmount(Money amount) const {
+    return amount > Money() && amount <= Money::fromCents(100000000); // Max $1M per transaction
+}
+
 void BankingSystem::displayWelcomeMessage() const {
     std::cout << "\nWelcome to Oyanib Banking System!\n";
     std::cout << "Your trusted financial partner.\n";
@@ -723,104 +1617,250 @@ void BankingSystem::displaySystemInfo() const {
 }
 
 // Helper methods
-void BankingSystem::loadCustomersFromFile() {
+void BankingSystem::loadCustomersFromFile(FileProfile& profile) {
+    TraceSpan span("loadCustomers", "persistence");
     std::ifstream file(customersFile);
     if (file.is_open()) {
         std::string line;
+        std::lock_guard<std::mutex> guard(customersMutex);
+        PhaseTimer timer(profile);
         while (std::getline(file, line)) {
+            profile.bytes += line.size() + 1;
+            timer.lap(PersistencePhase::Read);
             auto customer = std::make_shared<Customer>();
+            timer.lap(PersistencePhase::Construct);
             customer->fromFileString(line);
+            timer.lap(PersistencePhase::Parse);
             customers.push_back(customer);
+            profile.records++;
+            timer.lap(PersistencePhase::Index);
         }
         file.close();
     }
 }
 
-void BankingSystem::loadAccountsFromFile() {
+void BankingSystem::loadAccountsFromFile(FileProfile& profile) {
+    TraceSpan span("loadAccounts", "persistence");
     std::ifstream file(accountsFile);
     if (file.is_open()) {
         std::string line;
+        std::lock_guard<std::mutex> guard(accountsMutex);
+        PhaseTimer timer(profile);
         while (std::getline(file, line)) {
-            auto account = std::make_shared<Account>();
+            profile.bytes += line.size() + 1;
+            timer.lap(PersistencePhase::Read);
+            // The type is the second field; savings accounts carry extra fields of their own
+            size_t typeStart = line.find('|') + 1;
+            std::shared_ptr<Account> account;
+            if (typeStart != 0 && line.compare(typeStart, 8, "Savings|") == 0) {
+                account = std::make_shared<SavingsAccount>();
+            } else {
+                account = std::make_shared<Account>();
+            }
+            timer.lap(PersistencePhase::Construct);
             account->fromFileString(line);
+            timer.lap(PersistencePhase::Parse);
+            account->setStatistics(&statistics);
             accounts.push_back(account);
+            profile.records++;
+            timer.lap(PersistencePhase::Index);
         }
         file.close();
     }
 }
 
-void BankingSystem::loadTransactionsFromFile() {
-    std::ifstream file(transactionsFile);
-    if (file.is_open()) {
-        std::string line;
-        while (std::getline(file, line)) {
-            auto transaction = std::make_shared<Transaction>();
-            transaction->fromFileString(line);
-            transactions.push_back(transaction);
+void BankingSystem::loadTransactionsFromFile(FileProfile& profile) {
+    TraceSpan span("loadTransactions", "persistence");
+    // Only an offset index is built here; each account reads its own history on first use
+    if (transactionArchive.load(transactionsFile, profile)) {
+        PhaseTimer timer(profile);
+        statistics.recordPostings(transactionArchive.size(), transactionArchive.getCreditCents(),
+                                  transactionArchive.getDebitCents());
+        for (const auto& account : accounts) {
+            account->setArchive(&transactionArchive);
         }
-        file.close();
+        timer.lap(PersistencePhase::Index);
     }
 }
 
-void BankingSystem::loadLoansFromFile() {
+void BankingSystem::loadLoansFromFile(FileProfile& profile) {
+    TraceSpan span("loadLoans", "persistence");
     std::ifstream file(loansFile);
     if (file.is_open()) {
         std::string line;
+        std::lock_guard<std::mutex> guard(loansMutex);
+        PhaseTimer timer(profile);
         while (std::getline(file, line)) {
+            profile.bytes += line.size() + 1;
+            timer.lap(PersistencePhase::Read);
             auto loan = std::make_shared<Loan>();
+            timer.lap(PersistencePhase::Construct);
             loan->fromFileString(line);
+            timer.lap(PersistencePhase::Parse);
+            statistics.addLoan(*loan);
             loans.push_back(loan);
+            profile.records++;
+            timer.lap(PersistencePhase::Index);
         }
         file.close();
+        loanVersion.fetch_add(1);
     }
 }
 
-void BankingSystem::saveCustomersToFile() {
+void BankingSystem::saveCustomersToFile(FileProfile& profile) {
+    TraceSpan span("saveCustomers", "persistence");
     std::ofstream file(customersFile);
     if (file.is_open()) {
+        PhaseTimer timer(profile);
         for (const auto& customer : customers) {
-            file << customer->toFileString() << "\n";
+            std::string line = customer->toFileString();
+            timer.lap(PersistencePhase::Format);
+            file << line << "\n";
+            profile.bytes += line.size() + 1;
+            profile.records++;
+            timer.lap(PersistencePhase::Write);
         }
         file.close();
+        timer.lap(PersistencePhase::Write);
     }
 }
 
-void BankingSystem::saveAccountsToFile() {
+void BankingSystem::saveAccountsToFile(FileProfile& profile) {
+    TraceSpan span("saveAccounts", "persistence");
     std::ofstream file(accountsFile);
     if (file.is_open()) {
+        PhaseTimer timer(profile);
         for (const auto& account : accounts) {
-            file << account->toFileString() << "\n";
+            std::string line = account->toFileString();
+            timer.lap(PersistencePhase::Format);
+            file << line << "\n";
+            profile.bytes += line.size() + 1;
+            profile.records++;
+            timer.lap(PersistencePhase::Write);
         }
         file.close();
+        timer.lap(PersistencePhase::Write);
     }
 }
 
-void BankingSystem::saveTransactionsToFile() {
-    std::ofstream file(transactionsFile);
-    if (file.is_open()) {
-        for (const auto& transaction : transactions) {
-            file << transaction->toFileString() << "\n";
+bool BankingSystem::saveTransactionsToFile(FileProfile& profile) {
+    TraceSpan span("saveTransactions", "persistence");
+    // The archived prefix is already on disk and accounts still read from it:
+    // cut the file back to it and append the journal. The prefix was never
+    // loaded into memory, so if the file can't be cut it is left alone rather
+    // than rewritten without it
+    std::ofstream file;
+    if (transactionArchive.getByteCount() > 0) {
+        std::error_code code;
+        std::filesystem::resize_file(transactionsFile, transactionArchive.getByteCount(), code);
+        if (code) {
+            std::cerr << "Error: cannot save transactions to " << transactionsFile << ": " << code.message()
+                      << "; the file was not changed\n";
+            return false;
         }
-        file.close();
+        file.open(transactionsFile, std::ios::app);
+        if (file.is_open() && transactionArchive.needsLineBreak()) {
+            file << "\n";
+        }
+        profile.bytes += transactionArchive.getByteCount();
+        profile.records += transactionArchive.size();
+    } else {
+        file.open(transactionsFile);
     }
+    if (!file.is_open()) {
+        std::cerr << "Error: cannot open " << transactionsFile << " for writing\n";
+        return false;
+    }
+    PhaseTimer timer(profile);
+    transactions.forEach(0, transactions.size(), [&](const std::shared_ptr<Transaction>& transaction) {
+        std::string line = transaction->toFileString();
+        timer.lap(PersistencePhase::Format);
+        file << line << "\n";
+        profile.bytes += line.size() + 1;
+        profile.records++;
+        timer.lap(PersistencePhase::Write);
+    });
+    file.close();
+    timer.lap(PersistencePhase::Write);
+    return true;
 }
 
-void BankingSystem::saveLoansToFile() {
+void BankingSystem::saveLoansToFile(FileProfile& profile) {
+    TraceSpan span("saveLoans", "persistence");
     std::ofstream file(loansFile);
     if (file.is_open()) {
+        PhaseTimer timer(profile);
         for (const auto& loan : loans) {
-            file << loan->toFileString() << "\n";
+            std::string line = loan->toFileString();
+            timer.lap(PersistencePhase::Format);
+            file << line << "\n";
+            profile.bytes += line.size() + 1;
+            profile.records++;
+            timer.lap(PersistencePhase::Write);
         }
         file.close();
+        timer.lap(PersistencePhase::Write);
     }
 }
 
 std::string BankingSystem::getCurrentDateTime() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    return PeriodClock::shared().timestamp();
+}
+
+void BankingSystem::registerMetrics() {
+    MetricsRegistry& registry = MetricsRegistry::shared();
+    using Type = MetricsRegistry::Type;
+    registry.callback("oyanib_ledger_balance_dollars", "Sum of all account balances.", "", Type::Gauge,
+                      [this] { return statistics.getTotals().balance.toDouble(); }, this);
+    registry.callback("oyanib_journal_transactions", "Transactions in the journal.", "", Type::Gauge,
+                      [this] { return static_cast<double>(transactions.size()); }, this);
+    registry.callback("oyanib_journal_unsaved_transactions", "Journal entries posted since the last load or save.", "",
+                      Type::Gauge, [this] {
+                          size_t size = transactions.size();
+                          size_t saved = savedJournalSize.load(std::memory_order_relaxed);
+                          return static_cast<double>(size > saved ? size - saved : 0);
+                      }, this);
+    for (int i = 0; i < LedgerTotals::kLoanStatusCount; ++i) {
+        std::string status = LedgerStatistics::loanStatusName(i);
+        std::transform(status.begin(), status.end(), status.begin(), ::tolower);
+        std::string labels = "status=\"" + status + "\"";
+        registry.callback("oyanib_loans", "Loans, by status.", labels, Type::Gauge,
+                          [this, i] { return static_cast<double>(statistics.getTotals().loansByStatus[i].count); }, this);
+        registry.callback("oyanib_loans_outstanding_dollars", "Remaining loan balances, by status.", labels, Type::Gauge,
+                          [this, i] { return statistics.getTotals().loansByStatus[i].outstanding.toDouble(); }, this);
+    }
+}
+
+void BankingSystem::rebuildIndexes() {
+    customersByAccountNumber.clear();
+    customersById.clear();
+    accountIndex.clear();
+    loanIndex.clear();
+    
+    for (const auto& customer : customers) {
+        customersByAccountNumber[customer->getAccountNumber()] = customer;
+        customersById[customer->getUserId()] = customer;
+    }
+    
+    // Re-attach loaded accounts and loans to their owners
+    for (const auto& account : accounts) {
+        account->setJournal(&transactions);
+        account->setStatistics(&statistics);
+        accountIndex[account->getAccountNumber()] = account;
+        auto customer = findCustomerById(account->getCustomerId());
+        if (customer && !customer->getAccount(account->getAccountNumber())) {
+            customer->addAccount(account);
+        }
+    }
+    
+    for (const auto& loan : loans) {
+        loan->setPaymentLog(&loanPayments);
+        loanIndex[loan->getLoanId()] = loan;
+        auto customer = findCustomerById(loan->getCustomerId());
+        if (customer) {
+            customer->addLoan(loan);
+        }
+    }
 }
 
 void BankingSystem::createSampleData() {
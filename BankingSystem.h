@@ -6,33 +6,126 @@
 #include <unordered_map>
 #include <string>
 #include <fstream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
 
 #include "Customer.h"
 #include "Account.h"
 #include "Transaction.h"
 #include "Loan.h"
 #include "SavingsAccount.h"
+#include "TransactionJournal.h"
+#include "TransactionArchive.h"
+#include "LedgerSnapshot.h"
+#include "ThreadPool.h"
+#include "AdmissionController.h"
+#include "LedgerStatistics.h"
+#include "LoanAnalytics.h"
+#include "LatencyHistogram.h"
+#include "PersistenceProfile.h"
+#include "MemoryAccounting.h"
+#include "Tracer.h"
+#include "MetricsRegistry.h"
+
+// Result of a non-interactive ledger operation
+enum class OperationStatus {
+    Success,
+    InvalidAmount,
+    AccountNotFound,
+    LoanNotFound,
+    NotAuthorized,
+    Declined,
+    Throttled
+};
+
+// Outcome of one whole-bank batch job
+struct BatchJobReport {
+    std::string jobName;
+    size_t itemsProcessed;
+    double seconds;
+    size_t itemsChanged = 0; // Items whose outcome changed, for jobs that track it
+};
 
 class BankingSystem {
 private:
     std::vector<std::shared_ptr<Customer>> customers;
     std::vector<std::shared_ptr<Account>> accounts;
-    std::vector<std::shared_ptr<Transaction>> transactions;
+    TransactionJournal transactions; // Posted since startup
+    TransactionArchive transactionArchive; // Loaded from disk, read per account on demand
     std::vector<std::shared_ptr<Loan>> loans;
+    LoanPaymentLog loanPayments;
+    // Held while the customer/account/loan lists grow or shrink; snapshots
+    // and batch jobs copy the lists under these and walk the copies
+    mutable std::mutex customersMutex;
+    mutable std::mutex accountsMutex;
+    mutable std::mutex loansMutex;
+    
+    // Lookup indexes
+    std::unordered_map<std::string, std::shared_ptr<Customer>> customersByAccountNumber;
+    std::unordered_map<std::string, std::shared_ptr<Customer>> customersById;
+    std::unordered_map<std::string, std::shared_ptr<Account>> accountIndex;
+    std::unordered_map<std::string, std::shared_ptr<Loan>> loanIndex;
     
     // File paths for data persistence
     std::string customersFile;
     std::string accountsFile;
     std::string transactionsFile;
     std::string loansFile;
+    std::string loanPaymentsFile;
+    
+    // System statistics, maintained by the posting path
+    LedgerStatistics statistics;
+    
+    // Read snapshots: every ledger write runs inside a PostingScope and bumps
+    // the epoch; reports render from a snapshot pinned at a consistent cut
+    mutable std::atomic<uint64_t> ledgerEpoch;
+    mutable std::atomic<int> postingsInFlight;
+    mutable std::atomic<bool> snapshotBarrier;
+    mutable std::mutex snapshotMutex;
+    mutable std::shared_ptr<const LedgerSnapshot> currentSnapshot;
+    
+    // Whole-bank batch jobs run on a work-stealing pool, created on first use
+    std::unique_ptr<ThreadPool> batchPool;
+    std::once_flag batchPoolCreated; // The menu and the rollover thread may both ask first
+    BatchProgress batchProgress;
+    std::atomic<const char*> batchJobName;
+    std::mutex batchMutex; // One job on the pool at a time
+    
+    // Day/month rollover, run by a background scheduler shortly after local midnight
+    std::thread rolloverThread;
+    std::mutex rolloverMutex;
+    std::condition_variable rolloverWake;
+    bool rolloverStopping;
+    
+    // Loan book column store, rebuilt only when a loan has changed since the last build;
+    // deposits and withdrawals leave it alone
+    std::shared_ptr<const LoanAnalytics> loanAnalytics;
+    std::atomic<uint64_t> loanVersion; // Bumped after every loan change
     
-    // System statistics
-    double totalDeposits;
-    double totalWithdrawals;
-    double totalLoans;
-    int totalCustomers;
-    int totalAccounts;
-    int totalTransactions;
+    // Rate limits in front of the transaction API (unlimited until configured)
+    AdmissionController admission;
+    
+    // Latency of the transaction API, logins and load/save
+    LatencyRecorder latency;
+    
+    // Phase timings of the most recent load and save
+    mutable std::mutex profileMutex;
+    PersistenceProfile loadProfile;
+    PersistenceProfile saveProfile;
+    
+    // Journal length as of the last load or save; the rest is not on disk yet
+    std::atomic<size_t> savedJournalSize;
+    
+    class PostingScope {
+    private:
+        const BankingSystem& bank;
+    public:
+        explicit PostingScope(const BankingSystem& bank);
+        ~PostingScope();
+    };
 
 public:
     // Constructor and destructor
@@ -44,6 +137,7 @@ public:
                                             const std::string& phone, const std::string& address, 
                                             const std::string& password);
     std::shared_ptr<Customer> findCustomer(const std::string& accountNumber);
+    std::shared_ptr<Customer> findCustomerById(const std::string& customerId);
     std::shared_ptr<Customer> authenticateUser(const std::string& accountNumber, const std::string& password);
     void displayAllCustomers() const;
     void deleteCustomer(const std::string& accountNumber);
@@ -68,6 +162,27 @@ public:
     void viewLoanStatus(std::shared_ptr<Customer> customer) const;
     bool makeLoanPayment(std::shared_ptr<Customer> customer);
     void displayAllLoans() const;
+    std::shared_ptr<Loan> findLoan(const std::string& loanId);
+    std::vector<LoanGroupStats> analyzeLoans(LoanDimension dimension);
+    void displayLoanPortfolio();
+
+    // Non-interactive transaction API (used by the menus and the server front end)
+    OperationStatus deposit(const std::string& accountNumber, Money amount);
+    OperationStatus withdraw(const std::string& accountNumber, Money amount);
+    OperationStatus transfer(const std::string& sourceAccountNumber, 
+                             const std::string& targetAccountNumber, Money amount);
+    OperationStatus payLoan(const std::string& loanId, Money amount);
+    std::shared_ptr<Loan> requestLoan(std::shared_ptr<Customer> customer, const std::string& loanType, 
+                                      Money amount, int termMonths);
+    static std::string statusToString(OperationStatus status);
+
+    // Admission control
+    AdmissionController& getAdmissionController();
+    const AdmissionController& getAdmissionController() const;
+    
+    // Latency histograms
+    LatencyRecorder& getLatencyRecorder();
+    std::string dumpLatency() const; // One line: <op>:<count>:<p50>:<p99>:<p999>:<max> in ns, per operation
 
     // Account operations
     void displayAccountBalance(std::shared_ptr<Customer> customer) const;
@@ -75,34 +190,76 @@ public:
     void calculateInterest();
     void applyInterestToAllAccounts();
 
+    // Batch processing
+    std::vector<BatchJobReport> runEndOfDayBatch();
+    BatchJobReport resetPeriodCounters(bool monthly);
+    bool rolloverPeriods(); // Advances the period clock; resets counters if the day changed
+    void startRolloverScheduler();
+    void stopRolloverScheduler();
+    BatchJobReport rebuildAmortizationSchedules();
+    BatchJobReport rescoreCustomers(); // Credit scores and tiers; itemsChanged counts tier changes
+    void processEndOfDay();
+    BatchJobReport generateStatements(int year, int month, const std::string& baseDirectory = "statements");
+    void processMonthlyStatements();
+    const BatchProgress& getBatchProgress() const;
+    std::string getBatchJobName() const;
+
     // System operations
     void createNewAccount();
     void backupDatabase();
     void displaySystemStatistics() const;
+    MemoryReport measureMemory() const; // Holds postings back while it walks the ledger
+    void displayMemoryUsage() const;
     void loadData();
     void saveData();
+    PersistenceProfile getLoadProfile() const;
+    std::vector<std::string> getDataFiles() const;
+    PersistenceProfile getSaveProfile() const;
     void clearData();
 
+    // Read snapshots
+    std::shared_ptr<const LedgerSnapshot> pinSnapshot() const;
+
+    // Statistics: O(1) running totals, with a full recompute for auditing them
+    LedgerTotals getStatistics() const;
+    LedgerTotals recomputeStatistics() const;
+    bool auditStatistics() const;
+
     // Utility methods
-    void updateSystemStatistics();
     std::string generateReport() const;
     bool validateAccountNumber(const std::string& accountNumber) const;
     bool validateAmount(double amount) const;
+    bool validateAmount(Money amount) const;
     void displayWelcomeMessage() const;
     void displaySystemInfo() const;
 
 private:
     // Helper methods
-    void loadCustomersFromFile();
-    void loadAccountsFromFile();
-    void loadTransactionsFromFile();
-    void loadLoansFromFile();
-    void saveCustomersToFile();
-    void saveAccountsToFile();
-    void saveTransactionsToFile();
-    void saveLoansToFile();
+    void loadCustomersFromFile(FileProfile& profile);
+    void loadAccountsFromFile(FileProfile& profile);
+    void loadTransactionsFromFile(FileProfile& profile);
+    void loadLoansFromFile(FileProfile& profile);
+    void saveCustomersToFile(FileProfile& profile);
+    void saveAccountsToFile(FileProfile& profile);
+    bool saveTransactionsToFile(FileProfile& profile); // False if the file was left as it was
+    void saveLoansToFile(FileProfile& profile);
     std::string getCurrentDateTime() const;
     void createSampleData();
+    void rebuildIndexes();
+    void registerMetrics(); // Scrape-time gauges over the statistics and journal
+    ThreadPool& getBatchPool();
+    BatchJobReport runBatchJob(const char* jobName, size_t itemCount,
+                               const std::function<void(size_t, size_t)>& body);
+    BatchJobReport accrueInterest();
+    std::shared_ptr<const LoanAnalytics> getLoanAnalytics();
+    void beginPosting() const;
+    void endPosting() const;
+    std::shared_ptr<LedgerSnapshot> copyLedgerRows() const;
+    void copyLedgerCounters(LedgerSnapshot& snapshot) const;
+    std::vector<std::shared_ptr<Customer>> copyCustomerList() const;
+    std::vector<std::shared_ptr<Account>> copyAccountList() const;
+    std::vector<std::shared_ptr<Loan>> copyLoanList() const;
+    LedgerTotals readTotals() const;
 };
 
 #endif // BANKING_SYSTEM_H
@@ -1,30 +1,51 @@
 #include "Customer.h"
 #include "Account.h"
 #include "Loan.h"
+#include "MemoryAccounting.h"
 #include <iostream>
 #include <algorithm>
 #include <numeric>
 #include <iomanip>
 #include <sstream>
 
-Customer::Customer() : creditScore(650.0), customerType("Regular") {}
+Customer::Customer() : creditScore(650.0), customerType("Regular"), totalBalanceCents(0), activeLoanCount(0) {}
 
 Customer::Customer(const std::string& name, const std::string& email, const std::string& phone, 
                    const std::string& address, const std::string& password)
-    : User(name, email, phone, address, password), creditScore(650.0), customerType("Regular") {}
+    : User(name, email, phone, address, password), creditScore(650.0), customerType("Regular"),
+      totalBalanceCents(0), activeLoanCount(0) {}
 
-Customer::~Customer() {}
+Customer::~Customer() {
+    // Accounts and loans are shared and may outlive their owner
+    for (const auto& account : accounts) {
+        if (account->getOwner() == this) {
+            account->setOwner(nullptr);
+        }
+    }
+    for (const auto& loan : loans) {
+        if (loan->getOwner() == this) {
+            loan->setOwner(nullptr);
+        }
+    }
+}
 
 // Account management
 void Customer::addAccount(std::shared_ptr<Account> account) {
+    account->setOwner(this);
     accounts.push_back(account);
 }
 
 void Customer::removeAccount(const std::string& accountNumber) {
     accounts.erase(
         std::remove_if(accounts.begin(), accounts.end(),
-            [&accountNumber](const std::shared_ptr<Account>& account) {
-                return account->getAccountNumber() == accountNumber;
+            [this, &accountNumber](const std::shared_ptr<Account>& account) {
+                if (account->getAccountNumber() != accountNumber) {
+                    return false;
+                }
+                if (account->getOwner() == this) {
+                    account->setOwner(nullptr);
+                }
+                return true;
             }),
         accounts.end()
     );
@@ -49,6 +70,7 @@ int Customer::getAccountCount() const {
 
 // Loan management
 void Customer::addLoan(std::shared_ptr<Loan> loan) {
+    loan->setOwner(this);
     loans.push_back(loan);
 }
 
@@ -70,13 +92,16 @@ void Customer::setCreditScore(double score) {
 }
 
 void Customer::updateCreditScore() {
+    creditScore = calculateCreditScore(getTotalBalance(), hasActiveLoans());
+}
+
+double Customer::calculateCreditScore(Money totalBalance, bool hasActiveLoans) {
     // Simple credit score calculation based on account balance and loan history
     double baseScore = 650.0;
-    double balanceBonus = getTotalBalance() / 10000.0 * 50.0; // +50 points per $10k
-    double loanPenalty = hasActiveLoans() ? -50.0 : 0.0;
+    double balanceBonus = totalBalance.toDouble() / 10000.0 * 50.0; // +50 points per $10k
+    double loanPenalty = hasActiveLoans ? -50.0 : 0.0;
     
-    creditScore = baseScore + balanceBonus + loanPenalty;
-    creditScore = std::max(300.0, std::min(850.0, creditScore));
+    return std::max(300.0, std::min(850.0, baseScore + balanceBonus + loanPenalty));
 }
 
 // Customer type management
@@ -89,14 +114,16 @@ void Customer::setCustomerType(const std::string& type) {
 }
 
 void Customer::upgradeCustomerType() {
-    double totalBalance = getTotalBalance();
-    if (totalBalance >= 100000.0 && creditScore >= 750.0) {
-        customerType = "VIP";
-    } else if (totalBalance >= 50000.0 && creditScore >= 700.0) {
-        customerType = "Premium";
-    } else {
-        customerType = "Regular";
+    customerType = calculateCustomerType(getTotalBalance(), creditScore);
+}
+
+const char* Customer::calculateCustomerType(Money totalBalance, double creditScore) {
+    if (totalBalance >= Money::fromCents(10000000) && creditScore >= 750.0) {
+        return "VIP";
+    } else if (totalBalance >= Money::fromCents(5000000) && creditScore >= 700.0) {
+        return "Premium";
     }
+    return "Regular";
 }
 
 // Overridden methods
@@ -110,7 +137,7 @@ void Customer::displayInfo() const {
     std::cout << "Customer Type: " << customerType << "\n";
     std::cout << "Number of Accounts: " << getAccountCount() << "\n";
     std::cout << "Number of Loans: " << getLoanCount() << "\n";
-    std::cout << "Total Balance: $" << std::fixed << std::setprecision(2) << getTotalBalance() << "\n";
+    std::cout << "Total Balance: $" << getTotalBalance() << "\n";
     std::cout << "══════════════════════════════════════════════════════════════\n";
 }
 
@@ -138,11 +165,8 @@ void Customer::fromFileString(const std::string& data) {
 }
 
 // Customer-specific methods
-double Customer::getTotalBalance() const {
-    return std::accumulate(accounts.begin(), accounts.end(), 0.0,
-        [](double sum, const std::shared_ptr<Account>& account) {
-            return sum + account->getBalance();
-        });
+Money Customer::getTotalBalance() const {
+    return Money::fromCents(totalBalanceCents.load(std::memory_order_relaxed));
 }
 
 void Customer::displayAccountSummary() const {
@@ -152,7 +176,7 @@ void Customer::displayAccountSummary() const {
     std::cout << "Customer: " << getName() << " (" << getAccountNumber() << ")\n";
     std::cout << "Customer Type: " << customerType << "\n";
     std::cout << "Credit Score: " << creditScore << "\n";
-    std::cout << "Total Balance: $" << std::fixed << std::setprecision(2) << getTotalBalance() << "\n";
+    std::cout << "Total Balance: $" << getTotalBalance() << "\n";
     std::cout << "Number of Accounts: " << getAccountCount() << "\n";
     std::cout << "Number of Loans: " << getLoanCount() << "\n\n";
     
@@ -165,7 +189,7 @@ void Customer::displayAccountSummary() const {
         for (const auto& account : accounts) {
             std::cout << std::setw(15) << account->getAccountNumber()
                       << std::setw(15) << account->getAccountType()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << account->getBalance()
+                      << std::setw(15) << "$" << account->getBalanceMoney()
                       << std::setw(15) << (account->isActive() ? "Active" : "Inactive") << "\n";
         }
     }
@@ -178,7 +202,7 @@ void Customer::displayAccountSummary() const {
         
         for (const auto& loan : loans) {
             std::cout << std::setw(15) << loan->getLoanId()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << loan->getAmount()
+                      << std::setw(15) << "$" << loan->getAmountMoney()
                       << std::setw(15) << loan->getStatus()
                       << std::setw(15) << loan->getLoanType() << "\n";
         }
@@ -188,12 +212,41 @@ void Customer::displayAccountSummary() const {
 }
 
 bool Customer::hasActiveLoans() const {
-    return std::any_of(loans.begin(), loans.end(),
-        [](const std::shared_ptr<Loan>& loan) {
-            return loan->getStatus() == "Active";
-        });
+    return getActiveLoanCount() > 0;
+}
+
+int Customer::getActiveLoanCount() const {
+    return activeLoanCount.load(std::memory_order_relaxed);
 }
 
 bool Customer::isEligibleForLoan() const {
-    return creditScore >= 600.0 && !hasActiveLoans() && getTotalBalance() > 1000.0;
+    return creditScore >= 600.0 && !hasActiveLoans() && getTotalBalance() > Money::fromCents(100000);
+}
+
+// Cached aggregates
+void Customer::adjustTotalBalance(long long deltaCents) {
+    totalBalanceCents.fetch_add(deltaCents, std::memory_order_relaxed);
+}
+
+void Customer::adjustActiveLoans(int delta) {
+    activeLoanCount.fetch_add(delta, std::memory_order_relaxed);
+}
+
+Money Customer::recomputeTotalBalance() const {
+    long long totalCents = 0;
+    for (const auto& account : accounts) {
+        totalCents += account->getBalanceCents();
+    }
+    return Money::fromCents(totalCents);
+}
+
+// Memory accounting
+void Customer::addMemoryUsage(MemoryReport& report) const {
+    report.addShared(MemorySubsystem::Customers, sizeof(Customer));
+    for (const std::string* field : {&userId, &name, &email, &phone, &address, &password, &accountNumber,
+                                     &dateCreated, &customerType}) {
+        report.addString(*field);
+    }
+    report.addVector(MemorySubsystem::Lists, accounts);
+    report.addVector(MemorySubsystem::Lists, loans);
 }
@@ -4,9 +4,13 @@
 #include "User.h"
 #include <vector>
 #include <memory>
+#include <atomic>
+
+#include "Money.h"
 
 class Account;
 class Loan;
+class MemoryReport;
 
 class Customer : public User {
 private:
@@ -14,12 +18,17 @@ private:
     std::vector<std::shared_ptr<Loan>> loans;
     double creditScore;
     std::string customerType; // "Regular", "Premium", "VIP"
+    // Aggregates kept current by the owned accounts and loans themselves
+    std::atomic<long long> totalBalanceCents;
+    std::atomic<int> activeLoanCount;
 
 public:
     // Constructors
     Customer();
     Customer(const std::string& name, const std::string& email, const std::string& phone, 
              const std::string& address, const std::string& password);
+    Customer(const Customer&) = delete;
+    Customer& operator=(const Customer&) = delete;
     ~Customer();
 
     // Account management
@@ -44,6 +53,10 @@ public:
     void setCustomerType(const std::string& type);
     void upgradeCustomerType();
 
+    // Scoring rules, shared by the per-customer updates and the bulk rescoring job
+    static double calculateCreditScore(Money totalBalance, bool hasActiveLoans);
+    static const char* calculateCustomerType(Money totalBalance, double creditScore);
+
     // Overridden methods
     std::string getUserType() const override;
     void displayInfo() const override;
@@ -51,10 +64,19 @@ public:
     void fromFileString(const std::string& data) override;
 
     // Customer-specific methods
-    double getTotalBalance() const;
+    Money getTotalBalance() const;
     void displayAccountSummary() const;
     bool hasActiveLoans() const;
+    int getActiveLoanCount() const;
     bool isEligibleForLoan() const;
+
+    // Cached aggregates (called by owned accounts and loans as they change)
+    void adjustTotalBalance(long long deltaCents);
+    void adjustActiveLoans(int delta);
+    Money recomputeTotalBalance() const; // Full scan, for auditing the cached total
+    
+    // Memory accounting
+    void addMemoryUsage(MemoryReport& report) const;
 };
 
 #endif // CUSTOMER_H
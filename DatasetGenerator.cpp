@@ -0,0 +1,452 @@
+#include "DatasetGenerator.h"
+#include "ThreadPool.h"
+#include "PeriodClock.h"
+#include "Money.h"
+#include "Loan.h"
+#include "AmortizationEngine.h"
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cctype>
+
+namespace {
+
+// Independent random streams, so adding a field to one table never shifts another
+const uint64_t kCustomerStream = 1;
+const uint64_t kCustomerSinceStream = 2;
+const uint64_t kAccountStream = 3;
+const uint64_t kActivityStream = 4;
+const uint64_t kLoanStream = 5;
+
+const size_t kRecordBlock = 4096;   // Customers, accounts or loans rendered per block
+const size_t kPlanBlock = 65536;    // Accounts weighed per block when planning transactions
+const long long kHistoryDays = 1825;
+
+const char* const kFirstNames[] = {"James", "Mary", "Robert", "Patricia", "John", "Jennifer", "Michael", "Linda",
+                                   "David", "Elizabeth", "William", "Barbara", "Richard", "Susan", "Joseph", "Jessica",
+                                   "Thomas", "Sarah", "Amina", "Kwame", "Wei", "Priya", "Carlos", "Fatima"};
+const char* const kLastNames[] = {"Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis",
+                                  "Rodriguez", "Martinez", "Hernandez", "Lopez", "Wilson", "Anderson", "Thomas",
+                                  "Taylor", "Moore", "Jackson", "Okafor", "Mensah", "Chen", "Patel", "Silva", "Khan"};
+const char* const kStreets[] = {"Main St", "Oak Ave", "Maple Dr", "Cedar Ln", "Park Rd", "Lake View", "Hill St",
+                                "River Rd", "Elm St", "Pine Ave"};
+const char* const kCities[] = {"Springfield", "Riverside", "Fairview", "Franklin", "Greenville", "Madison",
+                               "Clinton", "Georgetown", "Salem", "Ashland"};
+
+template <typename T, size_t N>
+constexpr size_t countOf(T (&)[N]) { return N; }
+
+uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// SplitMix64 keyed by (seed, stream, record index)
+class RecordRandom {
+private:
+    uint64_t state;
+
+public:
+    RecordRandom(uint64_t seed, uint64_t stream, uint64_t index) : state(mix(seed ^ mix((stream << 56) ^ index))) {}
+
+    uint64_t next() {
+        state += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+    uint64_t below(uint64_t bound) { return bound ? next() % bound : 0; }
+
+    double normal() {
+        double u1 = std::max(uniform(), 1e-300);
+        double u2 = uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    // Dollar amounts with a long right tail, in whole cents
+    int64_t logNormalCents(double medianDollars, double sigma) {
+        return std::max<int64_t>(1, std::llround(medianDollars * std::exp(sigma * normal()) * 100.0));
+    }
+};
+
+std::string formatRate(double rate) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%g", rate);
+    return buffer;
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+// "YYYY-MM-DD HH:MM:SS" for seconds since 1970-01-01, reusing the date part while the day is unchanged
+class DateFormatter {
+private:
+    long long cachedDay = -1;
+    std::string cachedDate;
+
+public:
+    std::string format(long long seconds) {
+        long long day = seconds / 86400;
+        if (day != cachedDay) {
+            cachedDay = day;
+            cachedDate = PeriodClock::dateFromDays(day);
+        }
+        long long secondOfDay = seconds % 86400;
+        char time[16];
+        std::snprintf(time, sizeof(time), " %02lld:%02lld:%02lld", secondOfDay / 3600, secondOfDay / 60 % 60,
+                      secondOfDay % 60);
+        return cachedDate + time;
+    }
+};
+
+int creditScoreFrom(RecordRandom& random) {
+    return static_cast<int>(std::clamp(std::lround(690.0 + 60.0 * random.normal()), 300L, 850L));
+}
+
+} // namespace
+
+DatasetGenerator::DatasetGenerator(const DatasetSpec& spec)
+    : spec(spec), asOfDay(spec.asOfDay > 0 ? spec.asOfDay : PeriodClock::shared().getDayNumber()) {}
+
+// Generation
+DatasetReport DatasetGenerator::generate(ThreadPool& pool) {
+    DatasetReport report{false, "", spec.customers, spec.accounts, spec.transactions, spec.loans, 0, 0.0};
+    if ((spec.accounts > 0 || spec.loans > 0) && spec.customers == 0) {
+        report.error = "accounts and loans need at least one customer";
+        return report;
+    }
+    if (spec.transactions > 0 && spec.accounts == 0) {
+        report.error = "transactions need at least one account";
+        return report;
+    }
+
+    std::error_code directoryError;
+    std::filesystem::create_directories(spec.directory, directoryError);
+    if (directoryError) {
+        report.error = "cannot create " + spec.directory;
+        return report;
+    }
+    auto path = [this](const char* fileName) { return spec.directory + "/" + fileName; };
+
+    auto start = std::chrono::steady_clock::now();
+    planTransactions(pool);
+
+    bool written =
+        writeTable(pool, spec.customers, kRecordBlock, {path("customers.txt")},
+                   [this](size_t begin, size_t end, std::vector<std::string>& out) {
+                       renderCustomers(begin, end, out[0]);
+                   }, report.bytesWritten, report.error) &&
+        writeTable(pool, spec.accounts, kRecordBlock, {path("accounts.txt"), path("transactions.txt")},
+                   [this](size_t begin, size_t end, std::vector<std::string>& out) {
+                       renderAccounts(begin, end, out[0], out[1]);
+                   }, report.bytesWritten, report.error) &&
+        writeTable(pool, spec.loans, kRecordBlock, {path("loans.txt")},
+                   [this](size_t begin, size_t end, std::vector<std::string>& out) {
+                       renderLoans(begin, end, out[0]);
+                   }, report.bytesWritten, report.error);
+
+    // Payment history from an earlier dataset would attach to the new loan IDs
+    std::ofstream payments(path("loan_payments.txt"), std::ios::trunc);
+
+    transactionOffsets.clear();
+    transactionOffsets.shrink_to_fit();
+    report.success = written && payments.is_open();
+    if (written && !payments.is_open()) {
+        report.error = "cannot write " + path("loan_payments.txt");
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+const DatasetSpec& DatasetGenerator::getSpec() const {
+    return spec;
+}
+
+// Helper methods
+void DatasetGenerator::planTransactions(ThreadPool& pool) {
+    // Each account's share of the transactions is its weight over the total;
+    // block sums are reduced in a fixed order so the plan never depends on scheduling
+    size_t accountCount = spec.accounts;
+    transactionOffsets.assign(accountCount + 1, 0);
+    if (accountCount == 0) {
+        return;
+    }
+
+    size_t blockCount = (accountCount + kPlanBlock - 1) / kPlanBlock;
+    std::vector<double> blockWeights(blockCount, 0.0);
+    pool.parallelFor(0, blockCount, 1, [&](size_t firstBlock, size_t lastBlock) {
+        for (size_t block = firstBlock; block < lastBlock; ++block) {
+            double sum = 0.0;
+            size_t end = std::min(accountCount, (block + 1) * kPlanBlock);
+            for (size_t i = block * kPlanBlock; i < end; ++i) {
+                sum += activityWeight(i);
+            }
+            blockWeights[block] = sum;
+        }
+    });
+
+    std::vector<double> blockStarts(blockCount, 0.0);
+    double totalWeight = 0.0;
+    for (size_t block = 0; block < blockCount; ++block) {
+        blockStarts[block] = totalWeight;
+        totalWeight += blockWeights[block];
+    }
+
+    const double perWeight = static_cast<double>(spec.transactions) / totalWeight;
+    pool.parallelFor(0, blockCount, 1, [&](size_t firstBlock, size_t lastBlock) {
+        for (size_t block = firstBlock; block < lastBlock; ++block) {
+            double cumulative = blockStarts[block];
+            size_t end = std::min(accountCount, (block + 1) * kPlanBlock);
+            for (size_t i = block * kPlanBlock; i < end; ++i) {
+                transactionOffsets[i] = std::min<uint64_t>(spec.transactions,
+                                                           static_cast<uint64_t>(std::llround(cumulative * perWeight)));
+                cumulative += activityWeight(i);
+            }
+        }
+    });
+    transactionOffsets[accountCount] = spec.transactions;
+}
+
+bool DatasetGenerator::writeTable(ThreadPool& pool, size_t count, size_t blockSize,
+                                  const std::vector<std::string>& fileNames, const BlockRenderer& render,
+                                  uint64_t& bytesWritten, std::string& error) {
+    std::vector<std::ofstream> files;
+    for (const auto& fileName : fileNames) {
+        files.emplace_back(fileName, std::ios::trunc | std::ios::binary);
+        if (!files.back().is_open()) {
+            error = "cannot write " + fileName;
+            return false;
+        }
+    }
+
+    // A wave of blocks renders in parallel, then is appended in block order
+    size_t blockCount = (count + blockSize - 1) / blockSize;
+    size_t waveSize = std::max<size_t>(1, pool.getThreadCount() * 2);
+    std::vector<std::vector<std::string>> outputs(waveSize, std::vector<std::string>(files.size()));
+
+    for (size_t waveStart = 0; waveStart < blockCount; waveStart += waveSize) {
+        size_t waveEnd = std::min(blockCount, waveStart + waveSize);
+        pool.parallelFor(waveStart, waveEnd, 1, [&](size_t firstBlock, size_t lastBlock) {
+            for (size_t block = firstBlock; block < lastBlock; ++block) {
+                std::vector<std::string>& out = outputs[block - waveStart];
+                for (auto& text : out) {
+                    text.clear();
+                }
+                render(block * blockSize, std::min(count, (block + 1) * blockSize), out);
+            }
+        });
+
+        for (size_t block = waveStart; block < waveEnd; ++block) {
+            for (size_t f = 0; f < files.size(); ++f) {
+                const std::string& text = outputs[block - waveStart][f];
+                files[f].write(text.data(), static_cast<std::streamsize>(text.size()));
+                bytesWritten += text.size();
+            }
+        }
+    }
+
+    for (size_t f = 0; f < files.size(); ++f) {
+        files[f].close();
+        if (!files[f]) {
+            error = "write failed on " + fileNames[f];
+            return false;
+        }
+    }
+    return true;
+}
+
+void DatasetGenerator::renderCustomers(size_t begin, size_t end, std::string& out) const {
+    DateFormatter dates;
+    for (size_t i = begin; i < end; ++i) {
+        RecordRandom random(spec.seed, kCustomerStream, i);
+        std::string first = kFirstNames[random.below(countOf(kFirstNames))];
+        std::string last = kLastNames[random.below(countOf(kLastNames))];
+        long long since = asOfDay - kHistoryDays +
+                          static_cast<long long>(RecordRandom(spec.seed, kCustomerSinceStream, i).below(kHistoryDays - 30));
+
+        out += customerId(i);
+        out += "|" + first + " " + last;
+        out += "|" + toLower(first) + "." + toLower(last) + std::to_string(i) + "@example.com";
+        out += "|555" + std::to_string(1000000 + random.below(9000000));
+        out += "|" + std::to_string(1 + random.below(9999)) + " " + kStreets[random.below(countOf(kStreets))] +
+               ", " + kCities[random.below(countOf(kCities))];
+        out += "|password123";
+        out += "|" + std::to_string(100000000 + i);
+        out += "|1|" + dates.format(since * 86400 + static_cast<long long>(random.below(86400)));
+        out += "|Customer|" + std::to_string(creditScoreFrom(random)) + "|Regular\n";
+    }
+}
+
+void DatasetGenerator::renderAccounts(size_t begin, size_t end, std::string& accountsOut,
+                                      std::string& transactionsOut) const {
+    DateFormatter dates;
+    const long long asOfEnd = asOfDay * 86400 + 86399;
+
+    for (size_t i = begin; i < end; ++i) {
+        RecordRandom random(spec.seed, kAccountStream, i);
+        size_t owner = i < spec.customers ? i : static_cast<size_t>(random.below(spec.customers));
+        bool savings = random.uniform() < 0.4;
+        std::string number = accountNumber(i);
+
+        // Opened on or after the day its customer joined
+        long long since = asOfDay - kHistoryDays +
+                          static_cast<long long>(RecordRandom(spec.seed, kCustomerSinceStream, owner).below(kHistoryDays - 30));
+        long long opened = (since + static_cast<long long>(random.below(static_cast<uint64_t>(asOfDay - since)))) * 86400 +
+                           static_cast<long long>(random.below(86400));
+
+        Money minimum = savings ? Money::fromCents(50000) : Money();
+        Money balance = minimum + Money::fromCents(random.logNormalCents(1500.0, 1.0));
+
+        // Activity in date order from the opening balance; debits that would
+        // break the minimum become deposits, so every balance is reachable
+        uint64_t first = transactionOffsets[i];
+        uint64_t count = transactionOffsets[i + 1] - first;
+        double span = static_cast<double>(asOfEnd - opened);
+        for (uint64_t t = 0; t < count; ++t) {
+            long long when = opened + static_cast<long long>(span * (static_cast<double>(t) + random.uniform()) /
+                                                             static_cast<double>(count));
+            double kind = random.uniform();
+            Money amount = Money::fromCents(random.logNormalCents(80.0, 1.1));
+            const char* type;
+            if (savings && kind >= 0.90) {
+                type = "Interest";
+                amount = balance.interest(2.5, 12);
+            } else if (kind < 0.40) {
+                type = "Deposit";
+            } else if (kind < 0.70) {
+                type = "Withdrawal";
+                amount = -amount;
+            } else if (kind < 0.80) {
+                type = "Transfer In";
+            } else {
+                type = "Transfer Out";
+                amount = -amount;
+            }
+            if (amount == Money() || balance + amount < minimum) {
+                type = "Deposit";
+                amount = amount == Money() ? Money::fromCents(100) : amount.abs();
+            }
+            balance += amount;
+
+            transactionsOut += "TXN" + std::to_string(100000000 + first + t) + "|" + number + "|" + type + "|" +
+                               amount.toString() + "|" + balance.toString() + "|" + dates.format(when) + "||Completed\n";
+        }
+
+        accountsOut += number;
+        accountsOut += savings ? "|Savings|" : "|Checking|";
+        accountsOut += balance.toString() + (savings ? "|2.5|1|" : "|0|1|") + dates.format(opened);
+        accountsOut += "|" + customerId(owner) + "|" + minimum.toString();
+        accountsOut += savings ? "|2000.00|10000.00" : "|1000.00|5000.00";
+        accountsOut += "|0.00|0.00|" + PeriodClock::dateFromDays(opened / 86400);
+        if (savings) {
+            accountsOut += "|" + minimum.toString() + "|0|6|2.5";
+        }
+        accountsOut += '\n';
+    }
+}
+
+void DatasetGenerator::renderLoans(size_t begin, size_t end, std::string& out) const {
+    // Type, typical amount and terms on offer
+    struct LoanProfile {
+        const char* type;
+        double medianDollars;
+        int terms[4];
+    };
+    static const LoanProfile kProfiles[] = {
+        {"Personal", 8000.0, {12, 24, 36, 60}},
+        {"Home", 250000.0, {180, 240, 360, 360}},
+        {"Business", 60000.0, {36, 60, 84, 120}},
+        {"Education", 25000.0, {60, 120, 120, 180}},
+    };
+    static const double kProfileShares[] = {0.40, 0.65, 0.85, 1.0};
+
+    DateFormatter dates;
+    for (size_t i = begin; i < end; ++i) {
+        RecordRandom random(spec.seed, kLoanStream, i);
+        size_t customer = static_cast<size_t>(random.below(spec.customers));
+        double pick = random.uniform();
+        const LoanProfile& profile = kProfiles[std::upper_bound(kProfileShares, kProfileShares + 3, pick) - kProfileShares];
+
+        Money amount = Money::fromCents(std::max<int64_t>(10000, random.logNormalCents(profile.medianDollars, 0.5) / 10000 * 10000));
+        int term = profile.terms[random.below(4)];
+        int creditScore = creditScoreFrom(random);
+        double rate = Loan::calculateInterestRate(creditScore, profile.type);
+        Money payment = AmortizationEngine::shared().getMonthlyPayment(amount, rate, term);
+
+        // Status mix: Pending 10%, Approved 5%, Active 55%, Paid 20%, Defaulted 10%
+        double state = random.uniform();
+        std::string status = state < 0.10 ? "Pending" : state < 0.15 ? "Approved" : state < 0.70 ? "Active"
+                           : state < 0.90 ? "Paid" : "Defaulted";
+
+        // Months on book decide the application date and how many payments were made
+        int months = 0;
+        int paymentsMade = 0;
+        if (status == "Active") {
+            months = 1 + static_cast<int>(random.below(static_cast<uint64_t>(term - 1)));
+            paymentsMade = months;
+        } else if (status == "Paid") {
+            months = term + static_cast<int>(random.below(24));
+            paymentsMade = term;
+        } else if (status == "Defaulted") {
+            months = 3 + static_cast<int>(random.below(static_cast<uint64_t>(term)));
+            paymentsMade = static_cast<int>(months * (0.2 + 0.5 * random.uniform()));
+        }
+        long long applied = asOfDay - months * 30LL - 3 - static_cast<long long>(random.below(25));
+        long long approved = applied + 1 + static_cast<long long>(random.below(5));
+        long long disbursed = approved + static_cast<long long>(random.below(3));
+
+        // Payments settle the month's interest first, as Loan::makePayment does
+        Money remaining = amount;
+        Money paidPrincipal, paidInterest;
+        int paymentCount = 0;
+        for (; paymentCount < paymentsMade && remaining > Money(); ++paymentCount) {
+            Money interest = remaining.interest(rate, 12);
+            Money principal = payment - interest;
+            if (principal >= remaining || paymentCount + 1 == term) {
+                principal = remaining;
+            }
+            remaining -= principal;
+            paidPrincipal += principal;
+            paidInterest += interest;
+        }
+        if (status == "Paid") {
+            paidPrincipal += remaining;
+            remaining = Money();
+        }
+
+        bool wasApproved = state >= 0.10;
+        bool wasDisbursed = state >= 0.15;
+        out += "LOAN" + std::to_string(100000 + i) + "|" + customerId(customer) + "|" + profile.type + "|" +
+               amount.toString() + "|" + formatRate(rate) + "|" + std::to_string(term) + "|" + status + "|";
+        out += dates.format(applied * 86400 + 32400 + static_cast<long long>(random.below(28800))) + "|";
+        out += (wasApproved ? dates.format(approved * 86400 + 36000) : std::string()) + "|";
+        out += (wasDisbursed ? dates.format(disbursed * 86400 + 43200) : std::string()) + "|";
+        out += payment.toString() + "|" + remaining.toString() + "||" + std::to_string(creditScore) + "|" +
+               paidPrincipal.toString() + "|" + paidInterest.toString() + "|" + std::to_string(paymentCount) + "|";
+        // Each simulated payment settled one period's interest in full
+        out += std::to_string(paymentCount) + "|" + Money().toString() + "\n";
+    }
+}
+
+double DatasetGenerator::activityWeight(size_t accountIndex) const {
+    // Heavy tail: the busiest accounts see about fifty times the quietest
+    return 1.0 / (0.02 + RecordRandom(spec.seed, kActivityStream, accountIndex).uniform());
+}
+
+std::string DatasetGenerator::customerId(size_t customerIndex) const {
+    return "U" + std::to_string(100000 + customerIndex);
+}
+
+std::string DatasetGenerator::accountNumber(size_t accountIndex) const {
+    return std::to_string(200000000 + accountIndex);
+}
@@ -0,0 +1,76 @@
+#ifndef DATASET_GENERATOR_H
+#define DATASET_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+class ThreadPool;
+
+// What to generate
+struct DatasetSpec {
+    size_t customers = 1000;
+    size_t accounts = 2000;       // Roughly 40% Savings, the rest Checking
+    size_t transactions = 20000;
+    size_t loans = 200;           // Spread over every loan status
+    uint64_t seed = 42;
+    long long asOfDay = 0;        // Last day of activity (days since 1970-01-01); 0 = today
+    std::string directory = ".";  // Where customers.txt, accounts.txt, ... are written
+};
+
+// Outcome of one generator run
+struct DatasetReport {
+    bool success;
+    std::string error;
+    size_t customers;
+    size_t accounts;
+    size_t transactions;
+    size_t loans;
+    uint64_t bytesWritten;
+    double seconds;
+};
+
+// Synthetic bank data written straight to the persistence files.
+//
+// Every record is derived only from the seed and its own index, so the
+// output is byte-identical for a given spec however many threads build it.
+// Records are rendered in fixed-size blocks on the thread pool, a wave of
+// blocks at a time, and each wave is appended to the files in order before
+// the next starts; memory stays at a few blocks per worker regardless of
+// the dataset size.
+//
+// Account activity is skewed: a minority of accounts carry most of the
+// transactions. Each account's transactions are generated in date order
+// from its opening balance, so the balance column chains and the account's
+// balance is where its history ends.
+class DatasetGenerator {
+private:
+    DatasetSpec spec;
+    long long asOfDay;
+    std::vector<uint64_t> transactionOffsets; // Account i owns transactions [offsets[i], offsets[i + 1])
+
+public:
+    // Constructor
+    explicit DatasetGenerator(const DatasetSpec& spec);
+
+    // Generation
+    DatasetReport generate(ThreadPool& pool);
+    const DatasetSpec& getSpec() const;
+
+private:
+    using BlockRenderer = std::function<void(size_t, size_t, std::vector<std::string>&)>;
+
+    void planTransactions(ThreadPool& pool);
+    bool writeTable(ThreadPool& pool, size_t count, size_t blockSize, const std::vector<std::string>& fileNames,
+                    const BlockRenderer& render, uint64_t& bytesWritten, std::string& error);
+    void renderCustomers(size_t begin, size_t end, std::string& out) const;
+    void renderAccounts(size_t begin, size_t end, std::string& accountsOut, std::string& transactionsOut) const;
+    void renderLoans(size_t begin, size_t end, std::string& out) const;
+    double activityWeight(size_t accountIndex) const;
+    std::string customerId(size_t customerIndex) const;
+    std::string accountNumber(size_t accountIndex) const;
+};
+
+#endif // DATASET_GENERATOR_H
@@ -0,0 +1,48 @@
+#include "IdGenerator.h"
+#include <random>
+
+namespace {
+
+uint64_t splitMix(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+} // namespace
+
+// Constructor
+IdGenerator::IdGenerator() : seeded(false), seed(0), draws(0) {}
+
+IdGenerator& IdGenerator::shared() {
+    static IdGenerator generator;
+    return generator;
+}
+
+// Modes
+void IdGenerator::setSeed(uint64_t seed) {
+    this->seed.store(seed);
+    draws.store(0);
+    seeded.store(true);
+}
+
+void IdGenerator::useRandomDevice() {
+    seeded.store(false);
+}
+
+bool IdGenerator::isSeeded() const {
+    return seeded.load();
+}
+
+long long IdGenerator::next(long long low, long long high) {
+    const uint64_t range = static_cast<uint64_t>(high - low) + 1;
+    if (seeded.load(std::memory_order_relaxed)) {
+        uint64_t draw = draws.fetch_add(1, std::memory_order_relaxed);
+        return low + static_cast<long long>(splitMix(seed.load(std::memory_order_relaxed) ^ splitMix(draw)) % range);
+    }
+    // Seeded once per thread; reseeding from random_device per ID dominated bulk jobs
+    thread_local std::mt19937_64 gen(std::random_device{}());
+    std::uniform_int_distribution<long long> dis(low, high);
+    return dis(gen);
+}
@@ -0,0 +1,37 @@
+#ifndef ID_GENERATOR_H
+#define ID_GENERATOR_H
+
+#include <atomic>
+#include <cstdint>
+
+// Source of the random numbers in customer, account, transaction and loan IDs.
+//
+// Normally each thread draws from its own generator seeded once from
+// random_device. Once seeded, every draw is instead a pure function of the
+// seed and a draw counter, so a single-threaded run that creates the same
+// objects in the same order gets the same IDs (used by workload replay).
+class IdGenerator {
+private:
+    std::atomic<bool> seeded;
+    std::atomic<uint64_t> seed;
+    std::atomic<uint64_t> draws;
+
+public:
+    // Constructor
+    IdGenerator();
+    IdGenerator(const IdGenerator&) = delete;
+    IdGenerator& operator=(const IdGenerator&) = delete;
+
+    // Process-wide generator used by all ID assignments
+    static IdGenerator& shared();
+
+    // Modes
+    void setSeed(uint64_t seed); // Deterministic from the next draw on
+    void useRandomDevice();
+    bool isSeeded() const;
+
+    // Uniform in [low, high]
+    long long next(long long low, long long high);
+};
+
+#endif // ID_GENERATOR_H
@@ -0,0 +1,105 @@
+#include "InterestKernel.h"
+#include "Money.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define INTEREST_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+int64_t exactInterest(int64_t balanceCents, int64_t rateMicros, int32_t periodsPerYear) {
+    return Money::fromCents(balanceCents).interestAtMicros(rateMicros, periodsPerYear).getCents();
+}
+
+#ifdef INTEREST_KERNEL_X86
+// Adding 2^52 + 2^51 moves an integer below 2^51 into the mantissa, which
+// gives exact int64 <-> double conversion without AVX-512
+const double kMagic = 6755399441055744.0;
+const long long kInputLimit = (1LL << 51) - 1;
+
+// Processes whole groups of four and returns how many elements it covered.
+//
+// The double result rounds the same way as the integer path whenever the
+// product balance * rate is below 2^52: the product is then exact, and
+// the quotient's rounding error is smaller than its distance to the
+// nearest half cent, so round-half-even picks the same neighbour.
+__attribute__((target("avx2")))
+size_t accrueAvx2(const int64_t* balanceCents, const int64_t* rateMicros,
+                  const int32_t* periodsPerYear, int64_t* interestCents, size_t count) {
+    const __m256d magic = _mm256_set1_pd(kMagic);
+    const __m256i magicBits = _mm256_castpd_si256(magic);
+    const __m256d productLimit = _mm256_set1_pd(4503599627370496.0); // 2^52
+    const __m256d hundredMillion = _mm256_set1_pd(1e8);
+    const __m256d minPeriods = _mm256_set1_pd(1.0);
+    const __m256d maxPeriods = _mm256_set1_pd(1e6);
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    const __m256i upperInput = _mm256_set1_epi64x(kInputLimit);
+    const __m256i lowerInput = _mm256_set1_epi64x(-kInputLimit);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i balances = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(balanceCents + i));
+        __m256i rates = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rateMicros + i));
+        __m256d periods = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(periodsPerYear + i)));
+
+        __m256d balance = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(balances, magicBits)), magic);
+        __m256d rate = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(rates, magicBits)), magic);
+        __m256d product = _mm256_mul_pd(balance, rate);
+        __m256d quotient = _mm256_div_pd(product, _mm256_mul_pd(periods, hundredMillion));
+        __m256d rounded = _mm256_round_pd(quotient, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256i interest = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(rounded, magic)), magicBits);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(interestCents + i), interest);
+
+        // Lanes outside the range where doubles are provably exact
+        __m256i badInput = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpgt_epi64(balances, upperInput), _mm256_cmpgt_epi64(lowerInput, balances)),
+            _mm256_or_si256(_mm256_cmpgt_epi64(rates, upperInput), _mm256_cmpgt_epi64(lowerInput, rates)));
+        __m256d unsafe = _mm256_or_pd(_mm256_castsi256_pd(badInput),
+                                      _mm256_cmp_pd(_mm256_andnot_pd(signBit, product), productLimit, _CMP_NLT_UQ));
+        unsafe = _mm256_or_pd(unsafe, _mm256_cmp_pd(periods, minPeriods, _CMP_LT_OQ));
+        unsafe = _mm256_or_pd(unsafe, _mm256_cmp_pd(periods, maxPeriods, _CMP_GT_OQ));
+
+        int lanes = _mm256_movemask_pd(unsafe);
+        if (lanes != 0) {
+            for (int lane = 0; lane < 4; ++lane) {
+                if (lanes & (1 << lane)) {
+                    size_t k = i + static_cast<size_t>(lane);
+                    interestCents[k] = exactInterest(balanceCents[k], rateMicros[k], periodsPerYear[k]);
+                }
+            }
+        }
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+void InterestKernel::accrue(const int64_t* balanceCents, const int64_t* rateMicros,
+                            const int32_t* periodsPerYear, int64_t* interestCents, size_t count) {
+    size_t done = 0;
+#ifdef INTEREST_KERNEL_X86
+    if (hasAvx2()) {
+        done = accrueAvx2(balanceCents, rateMicros, periodsPerYear, interestCents, count);
+    }
+#endif
+    accrueScalar(balanceCents + done, rateMicros + done, periodsPerYear + done,
+                 interestCents + done, count - done);
+}
+
+void InterestKernel::accrueScalar(const int64_t* balanceCents, const int64_t* rateMicros,
+                                  const int32_t* periodsPerYear, int64_t* interestCents, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        interestCents[i] = exactInterest(balanceCents[i], rateMicros[i], periodsPerYear[i]);
+    }
+}
+
+bool InterestKernel::hasAvx2() {
+#ifdef INTEREST_KERNEL_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
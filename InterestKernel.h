@@ -0,0 +1,23 @@
+#ifndef INTEREST_KERNEL_H
+#define INTEREST_KERNEL_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Interest accrual over contiguous columns of balances and rates.
+//
+// interestCents[i] is exactly what Money::interestAtMicros gives for
+// balanceCents[i], rateMicros[i] and periodsPerYear[i] (rounded half to
+// even). On CPUs with AVX2 four accounts are computed per instruction in
+// double precision; any lane whose result could be off by a rounding step
+// (very large products or interest) is redone with the integer path.
+class InterestKernel {
+public:
+    static void accrue(const int64_t* balanceCents, const int64_t* rateMicros,
+                       const int32_t* periodsPerYear, int64_t* interestCents, size_t count);
+    static void accrueScalar(const int64_t* balanceCents, const int64_t* rateMicros,
+                             const int32_t* periodsPerYear, int64_t* interestCents, size_t count);
+    static bool hasAvx2();
+};
+
+#endif // INTEREST_KERNEL_H
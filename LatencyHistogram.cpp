@@ -0,0 +1,203 @@
+#include "LatencyHistogram.h"
+
+namespace {
+
+std::atomic<uint64_t> nextRecorderId(1);
+
+// Last shard this thread used; a thread normally records into one bank
+struct CachedShard {
+    uint64_t recorderId = 0;
+    void* shard = nullptr;
+};
+thread_local CachedShard cachedShard;
+
+void increment(std::atomic<uint64_t>& counter, uint64_t amount) {
+    // Only the owning thread writes a shard, so no read-modify-write is needed
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace
+
+// LatencyHistogram
+LatencyHistogram::LatencyHistogram() : counts(kBucketCount, 0), total(0), sum(0), maxValue(0) {}
+
+void LatencyHistogram::record(uint64_t value, uint64_t count) {
+    addBucket(bucketIndex(value), count);
+    addSummary(value * count, value);
+}
+
+void LatencyHistogram::addBucket(int index, uint64_t count) {
+    counts[index] += count;
+    total += count;
+}
+
+void LatencyHistogram::addSummary(uint64_t sum, uint64_t maxValue) {
+    this->sum += sum;
+    if (maxValue > this->maxValue) {
+        this->maxValue = maxValue;
+    }
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return total;
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return maxValue;
+}
+
+double LatencyHistogram::getMean() const {
+    return total ? static_cast<double>(sum) / static_cast<double>(total) : 0.0;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (total == 0) {
+        return 0;
+    }
+    // Smallest bucket whose running count reaches the rank
+    uint64_t rank = static_cast<uint64_t>(percent / 100.0 * static_cast<double>(total) + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t bound = bucketUpperBound(i);
+            return bound < maxValue ? bound : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < 2 * kSubBuckets) {
+        return static_cast<int>(value);
+    }
+    int topBit = 63 - __builtin_clzll(value);
+    int shift = topBit - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + static_cast<int>((value >> shift) - kSubBuckets);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < 2 * kSubBuckets) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = index / kSubBuckets - 1;
+    uint64_t lower = static_cast<uint64_t>(index % kSubBuckets + kSubBuckets) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+// LatencyRecorder
+LatencyRecorder::Shard::Shard() {
+    for (int op = 0; op < kOperationCount; ++op) {
+        for (auto& counter : counts[op]) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        sums[op].store(0, std::memory_order_relaxed);
+        maxima[op].store(0, std::memory_order_relaxed);
+    }
+}
+
+LatencyRecorder::LatencyRecorder() : id(nextRecorderId.fetch_add(1)) {}
+
+// Recording
+void LatencyRecorder::record(LatencyOperation operation, uint64_t nanoseconds) {
+    Shard& shard = localShard();
+    int op = static_cast<int>(operation);
+    increment(shard.counts[op][LatencyHistogram::bucketIndex(nanoseconds)], 1);
+    increment(shard.sums[op], nanoseconds);
+    if (nanoseconds > shard.maxima[op].load(std::memory_order_relaxed)) {
+        shard.maxima[op].store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+// Reporting
+LatencyHistogram LatencyRecorder::getHistogram(LatencyOperation operation) const {
+    int op = static_cast<int>(operation);
+    LatencyHistogram merged;
+    std::lock_guard<std::mutex> guard(shardsLock);
+    for (const auto& shard : shards) {
+        for (int i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+            uint64_t count = shard->counts[op][i].load(std::memory_order_relaxed);
+            if (count) {
+                merged.addBucket(i, count);
+            }
+        }
+        merged.addSummary(shard->sums[op].load(std::memory_order_relaxed),
+                          shard->maxima[op].load(std::memory_order_relaxed));
+    }
+    return merged;
+}
+
+void LatencyRecorder::reset() {
+    std::lock_guard<std::mutex> guard(shardsLock);
+    for (const auto& shard : shards) {
+        for (int op = 0; op < kOperationCount; ++op) {
+            for (auto& counter : shard->counts[op]) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            shard->sums[op].store(0, std::memory_order_relaxed);
+            shard->maxima[op].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+const char* LatencyRecorder::operationName(LatencyOperation operation) {
+    switch (operation) {
+        case LatencyOperation::Deposit: return "Deposit";
+        case LatencyOperation::Withdraw: return "Withdraw";
+        case LatencyOperation::Transfer: return "Transfer";
+        case LatencyOperation::Authenticate: return "Login";
+        case LatencyOperation::LoanPayment: return "Loan payment";
+        case LatencyOperation::LoadData: return "Load data";
+        case LatencyOperation::SaveData: return "Save data";
+    }
+    return "Unknown";
+}
+
+const char* LatencyRecorder::operationKey(LatencyOperation operation) {
+    switch (operation) {
+        case LatencyOperation::Deposit: return "deposit";
+        case LatencyOperation::Withdraw: return "withdraw";
+        case LatencyOperation::Transfer: return "transfer";
+        case LatencyOperation::Authenticate: return "login";
+        case LatencyOperation::LoanPayment: return "loan_payment";
+        case LatencyOperation::LoadData: return "load";
+        case LatencyOperation::SaveData: return "save";
+    }
+    return "unknown";
+}
+
+// Helper methods
+LatencyRecorder::Shard& LatencyRecorder::localShard() {
+    if (cachedShard.recorderId == id) {
+        return *static_cast<Shard*>(cachedShard.shard);
+    }
+    // First record from this thread, or the thread last used another recorder
+    thread_local std::vector<std::pair<uint64_t, Shard*>> ownShards;
+    Shard* shard = nullptr;
+    for (const auto& entry : ownShards) {
+        if (entry.first == id) {
+            shard = entry.second;
+        }
+    }
+    if (!shard) {
+        std::lock_guard<std::mutex> guard(shardsLock);
+        shards.push_back(std::make_unique<Shard>());
+        shard = shards.back().get();
+        ownShards.emplace_back(id, shard);
+    }
+    cachedShard.recorderId = id;
+    cachedShard.shard = shard;
+    return *shard;
+}
+
+// LatencyTimer
+LatencyTimer::LatencyTimer(LatencyRecorder& recorder, LatencyOperation operation)
+    : recorder(recorder), operation(operation), start(std::chrono::steady_clock::now()) {}
+
+LatencyTimer::~LatencyTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    recorder.record(operation, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
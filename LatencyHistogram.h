@@ -0,0 +1,113 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+// Operations whose latency the bank records
+enum class LatencyOperation {
+    Deposit,
+    Withdraw,
+    Transfer,
+    Authenticate,
+    LoanPayment,
+    LoadData,
+    SaveData
+};
+
+// Log-linear (HDR-style) histogram of nanosecond values.
+//
+// Values below 64 get a bucket each; above that every power of two is
+// split into 32 buckets, so any recorded value is known to within about
+// 3% while the whole 64-bit range fits in under 2,000 counters.
+class LatencyHistogram {
+public:
+    static const int kSubBucketBits = 5;
+    static const int kSubBuckets = 1 << kSubBucketBits;
+    static const int kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t sum;
+    uint64_t maxValue;
+
+public:
+    // Constructor
+    LatencyHistogram();
+
+    // Recording and merging
+    void record(uint64_t value, uint64_t count = 1);
+    void addBucket(int index, uint64_t count);
+    void addSummary(uint64_t sum, uint64_t maxValue);
+
+    // Queries
+    uint64_t getCount() const;
+    uint64_t getMax() const;
+    double getMean() const;
+    uint64_t percentile(double percent) const; // Upper bound of the bucket holding that rank, capped at the max
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+};
+
+// Latency histograms for every operation, recorded per thread.
+//
+// Each thread that records gets its own shard of counters on first use, so
+// the hot path is a thread-local lookup and a few uncontended relaxed
+// stores. Reads merge all shards under a lock; shards outlive their
+// threads so nothing recorded is lost.
+class LatencyRecorder {
+public:
+    static const int kOperationCount = 7;
+
+private:
+    struct Shard {
+        std::atomic<uint64_t> counts[kOperationCount][LatencyHistogram::kBucketCount];
+        std::atomic<uint64_t> sums[kOperationCount];
+        std::atomic<uint64_t> maxima[kOperationCount];
+        Shard();
+    };
+
+    const uint64_t id; // Distinguishes recorders in the thread-local shard cache
+    mutable std::mutex shardsLock;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+public:
+    // Constructor
+    LatencyRecorder();
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    // Recording
+    void record(LatencyOperation operation, uint64_t nanoseconds);
+
+    // Reporting
+    LatencyHistogram getHistogram(LatencyOperation operation) const;
+    void reset(); // Records racing with a reset may survive it
+    static const char* operationName(LatencyOperation operation);
+    static const char* operationKey(LatencyOperation operation); // Short lowercase form for dumps
+
+private:
+    Shard& localShard();
+};
+
+// Records the lifetime of a scope as one sample
+class LatencyTimer {
+private:
+    LatencyRecorder& recorder;
+    LatencyOperation operation;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    LatencyTimer(LatencyRecorder& recorder, LatencyOperation operation);
+    ~LatencyTimer();
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,55 @@
+#ifndef LEDGER_SNAPSHOT_H
+#define LEDGER_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Money.h"
+#include "LedgerStatistics.h"
+
+class Account;
+class Loan;
+class TransactionJournal;
+class TransactionArchive;
+
+// Point-in-time view of the ledger used by reports and admin listings.
+//
+// A snapshot is pinned at a ledger epoch: the totals and journal length are
+// read at that exact cut, and so are the mutable per-row values (balances,
+// status) when no posting overlaps the copy. Under steady write load the
+// rows are copied while postings continue instead, each row consistent in
+// itself but possibly a little older than the cut. The immutable identity
+// fields are read through the shared pointers. Transactions are
+// not copied at all; the snapshot just remembers how much of the
+// append-only journal existed when it was taken, behind the archive of
+// transactions loaded at startup.
+struct LedgerSnapshot {
+    struct AccountRow {
+        std::shared_ptr<const Account> account;
+        bool active;
+    };
+
+    struct LoanRow {
+        std::shared_ptr<const Loan> loan;
+        std::string status;
+        Money remainingBalance;
+    };
+
+    uint64_t epoch;
+    std::string takenAt;
+    std::vector<AccountRow> accounts;
+    std::vector<Money> balances; // Parallel to accounts, kept contiguous for fast sums
+    std::vector<LoanRow> loans;
+    size_t customerCount;
+    const TransactionArchive* archive;
+    size_t archiveLength;
+    const TransactionJournal* journal;
+    size_t journalLength;
+
+    // Statistics as of the same cut
+    LedgerTotals totals;
+};
+
+#endif // LEDGER_SNAPSHOT_H
@@ -0,0 +1,119 @@
+#include "LedgerStatistics.h"
+#include "Loan.h"
+
+namespace {
+
+const char* const kLoanStatusNames[LedgerTotals::kLoanStatusCount] = {
+    "Pending", "Approved", "Active", "Paid", "Defaulted"
+};
+
+} // namespace
+
+bool LedgerTotals::operator==(const LedgerTotals& other) const {
+    if (customers != other.customers || accounts != other.accounts || transactions != other.transactions ||
+        deposits != other.deposits || withdrawals != other.withdrawals || balance != other.balance ||
+        loans != other.loans || loanAmount != other.loanAmount) {
+        return false;
+    }
+    for (int i = 0; i < kLoanStatusCount; ++i) {
+        if (loansByStatus[i].count != other.loansByStatus[i].count ||
+            loansByStatus[i].amount != other.loansByStatus[i].amount ||
+            loansByStatus[i].outstanding != other.loansByStatus[i].outstanding) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LedgerStatistics::LedgerStatistics() {
+    reset();
+}
+
+// Posting path
+void LedgerStatistics::addBalance(long long deltaCents) {
+    balanceCents.fetch_add(deltaCents, std::memory_order_relaxed);
+}
+
+void LedgerStatistics::recordPosting(long long amountCents) {
+    transactionCount.fetch_add(1, std::memory_order_relaxed);
+    if (amountCents > 0) {
+        creditCents.fetch_add(amountCents, std::memory_order_relaxed);
+    } else {
+        debitCents.fetch_sub(amountCents, std::memory_order_relaxed);
+    }
+}
+
+void LedgerStatistics::recordPostings(size_t count, long long creditCentsTotal, long long debitCentsTotal) {
+    transactionCount.fetch_add(count, std::memory_order_relaxed);
+    creditCents.fetch_add(creditCentsTotal, std::memory_order_relaxed);
+    debitCents.fetch_add(debitCentsTotal, std::memory_order_relaxed);
+}
+
+void LedgerStatistics::addLoan(const Loan& loan) {
+    adjustLoan(loan, 1);
+}
+
+void LedgerStatistics::removeLoan(const Loan& loan) {
+    adjustLoan(loan, -1);
+}
+
+// Queries
+LedgerTotals LedgerStatistics::getTotals() const {
+    LedgerTotals totals{};
+    totals.transactions = transactionCount.load(std::memory_order_relaxed);
+    totals.deposits = Money::fromCents(creditCents.load(std::memory_order_relaxed));
+    totals.withdrawals = Money::fromCents(debitCents.load(std::memory_order_relaxed));
+    totals.balance = Money::fromCents(balanceCents.load(std::memory_order_relaxed));
+    totals.loans = loanCount.load(std::memory_order_relaxed);
+    totals.loanAmount = Money::fromCents(loanAmountCents.load(std::memory_order_relaxed));
+    for (int i = 0; i < LedgerTotals::kLoanStatusCount; ++i) {
+        totals.loansByStatus[i].count = loanStatusCount[i].load(std::memory_order_relaxed);
+        totals.loansByStatus[i].amount = Money::fromCents(loanStatusAmountCents[i].load(std::memory_order_relaxed));
+        totals.loansByStatus[i].outstanding =
+            Money::fromCents(loanStatusOutstandingCents[i].load(std::memory_order_relaxed));
+    }
+    return totals;
+}
+
+void LedgerStatistics::reset() {
+    balanceCents.store(0);
+    transactionCount.store(0);
+    creditCents.store(0);
+    debitCents.store(0);
+    loanCount.store(0);
+    loanAmountCents.store(0);
+    for (int i = 0; i < LedgerTotals::kLoanStatusCount; ++i) {
+        loanStatusCount[i].store(0);
+        loanStatusAmountCents[i].store(0);
+        loanStatusOutstandingCents[i].store(0);
+    }
+}
+
+// Loan status buckets
+int LedgerStatistics::loanStatusIndex(const std::string& status) {
+    for (int i = 0; i < LedgerTotals::kLoanStatusCount; ++i) {
+        if (status == kLoanStatusNames[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* LedgerStatistics::loanStatusName(int index) {
+    return index >= 0 && index < LedgerTotals::kLoanStatusCount ? kLoanStatusNames[index] : "Other";
+}
+
+// Helper methods
+void LedgerStatistics::adjustLoan(const Loan& loan, int sign) {
+    long long amount = loan.getAmountMoney().getCents() * sign;
+    loanCount.fetch_add(static_cast<size_t>(sign), std::memory_order_relaxed);
+    loanAmountCents.fetch_add(amount, std::memory_order_relaxed);
+
+    int index = loanStatusIndex(loan.getStatus());
+    if (index >= 0) {
+        loanStatusCount[index].fetch_add(static_cast<size_t>(sign), std::memory_order_relaxed);
+        loanStatusAmountCents[index].fetch_add(amount, std::memory_order_relaxed);
+        loanStatusOutstandingCents[index].fetch_add(loan.getRemainingBalanceMoney().getCents() * sign,
+                                                    std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef LEDGER_STATISTICS_H
+#define LEDGER_STATISTICS_H
+
+#include <string>
+#include <atomic>
+#include <cstddef>
+
+#include "Money.h"
+
+class Loan;
+
+// Loan book totals for one loan status
+struct LoanStatusTotals {
+    size_t count;
+    Money amount;       // Original principal
+    Money outstanding;  // Remaining balance
+};
+
+// Plain copy of the bank-wide aggregates
+struct LedgerTotals {
+    static const int kLoanStatusCount = 5; // Pending, Approved, Active, Paid, Defaulted
+
+    size_t customers;
+    size_t accounts;
+    size_t transactions;
+    Money deposits;     // Sum of journal credits
+    Money withdrawals;  // Sum of journal debits
+    Money balance;      // Sum of account balances
+    size_t loans;
+    Money loanAmount;   // Principal across every loan, whatever its status
+    LoanStatusTotals loansByStatus[kLoanStatusCount];
+
+    bool operator==(const LedgerTotals& other) const;
+    bool operator!=(const LedgerTotals& other) const { return !(*this == other); }
+};
+
+// Bank-wide aggregates kept current by the posting path.
+//
+// Accounts report every balance change and the journal reports every
+// posting, so reading the totals never scans the ledger. All counters are
+// relaxed atomics: concurrent postings only ever add to them, and readers
+// that need a consistent cut take it while no posting is in flight.
+class LedgerStatistics {
+private:
+    std::atomic<long long> balanceCents;
+    std::atomic<size_t> transactionCount;
+    std::atomic<long long> creditCents;
+    std::atomic<long long> debitCents;
+    std::atomic<size_t> loanCount;
+    std::atomic<long long> loanAmountCents;
+    std::atomic<size_t> loanStatusCount[LedgerTotals::kLoanStatusCount];
+    std::atomic<long long> loanStatusAmountCents[LedgerTotals::kLoanStatusCount];
+    std::atomic<long long> loanStatusOutstandingCents[LedgerTotals::kLoanStatusCount];
+
+public:
+    // Constructor
+    LedgerStatistics();
+    LedgerStatistics(const LedgerStatistics&) = delete;
+    LedgerStatistics& operator=(const LedgerStatistics&) = delete;
+
+    // Posting path
+    void addBalance(long long deltaCents);
+    void recordPosting(long long amountCents);
+    void recordPostings(size_t count, long long creditCentsTotal, long long debitCentsTotal);
+
+    // Loans are removed before a change and added back after it
+    void addLoan(const Loan& loan);
+    void removeLoan(const Loan& loan);
+
+    // Queries
+    LedgerTotals getTotals() const; // Counts of customers and accounts are left at zero
+    void reset();
+
+    // Loan status buckets (-1 for statuses outside the known set)
+    static int loanStatusIndex(const std::string& status);
+    static const char* loanStatusName(int index);
+
+private:
+    void adjustLoan(const Loan& loan, int sign);
+};
+
+#endif // LEDGER_STATISTICS_H
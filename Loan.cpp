@@ -1,45 +1,35 @@
 #include "Loan.h"
-#include "Transaction.h"
+#include "AmortizationEngine.h"
+#include "Customer.h"
+#include "MemoryAccounting.h"
+#include "IdGenerator.h"
+#include "MetricsRegistry.h"
+#include "PeriodClock.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
-#include <ctime>
-#include <random>
+#include <algorithm>
 #include <cmath>
 
-Loan::Loan() : amount(0.0), interestRate(0.0), termMonths(0), monthlyPayment(0.0), 
-               remainingBalance(0.0), creditScore(0.0) {
+Loan::Loan() : amount(), interestRate(0.0), termMonths(0), monthlyPayment(), 
+               remainingBalance(), paidPrincipal(), paidInterest(), paymentCount(0), interestPeriods(0),
+               accruedInterest(), paymentLog(nullptr),
+               creditScore(0.0), owner(nullptr) {
     generateLoanId();
     dateApplied = getCurrentDateTime();
     status = "Pending";
 }
 
-Loan::Loan(const std::string& customerId, const std::string& loanType, double amount, 
+Loan::Loan(const std::string& customerId, const std::string& loanType, Money amount, 
            int termMonths, double creditScore)
     : customerId(customerId), loanType(loanType), amount(amount), termMonths(termMonths), 
-      creditScore(creditScore), monthlyPayment(0.0), remainingBalance(amount) {
+      creditScore(creditScore), monthlyPayment(), remainingBalance(amount), paidPrincipal(), paidInterest(),
+      paymentCount(0), interestPeriods(0), accruedInterest(), paymentLog(nullptr), owner(nullptr) {
     generateLoanId();
     dateApplied = getCurrentDateTime();
     status = "Pending";
     
-    // Set interest rate based on credit score and loan type
-    if (creditScore >= 750) {
-        interestRate = 5.0; // Excellent credit
-    } else if (creditScore >= 700) {
-        interestRate = 7.0; // Good credit
-    } else if (creditScore >= 650) {
-        interestRate = 9.0; // Fair credit
-    } else {
-        interestRate = 12.0; // Poor credit
-    }
-    
-    // Adjust rate based on loan type
-    if (loanType == "Home") {
-        interestRate -= 1.0; // Lower rate for home loans
-    } else if (loanType == "Education") {
-        interestRate -= 0.5; // Lower rate for education loans
-    }
-    
+    interestRate = calculateInterestRate(creditScore, loanType);
     calculateMonthlyPayment();
 }
 
@@ -49,15 +39,30 @@ Loan::~Loan() {}
 std::string Loan::getLoanId() const { return loanId; }
 std::string Loan::getCustomerId() const { return customerId; }
 std::string Loan::getLoanType() const { return loanType; }
-double Loan::getAmount() const { return amount; }
+double Loan::getAmount() const { return amount.toDouble(); }
+Money Loan::getAmountMoney() const { return amount; }
 double Loan::getInterestRate() const { return interestRate; }
 int Loan::getTermMonths() const { return termMonths; }
-std::string Loan::getStatus() const { return status; }
+std::string Loan::getStatus() const {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    return status;
+}
 std::string Loan::getDateApplied() const { return dateApplied; }
 std::string Loan::getDateApproved() const { return dateApproved; }
 std::string Loan::getDateDisbursed() const { return dateDisbursed; }
-double Loan::getMonthlyPayment() const { return monthlyPayment; }
-double Loan::getRemainingBalance() const { return remainingBalance; }
+double Loan::getMonthlyPayment() const { return monthlyPayment.toDouble(); }
+double Loan::getRemainingBalance() const { return getRemainingBalanceMoney().toDouble(); }
+Money Loan::getMonthlyPaymentMoney() const { return monthlyPayment; }
+Money Loan::getRemainingBalanceMoney() const {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    return remainingBalance;
+}
+
+void Loan::getState(std::string& status, Money& remainingBalance) const {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    status = this->status;
+    remainingBalance = this->remainingBalance;
+}
 std::string Loan::getDescription() const { return description; }
 double Loan::getCreditScore() const { return creditScore; }
 
@@ -65,80 +70,167 @@ double Loan::getCreditScore() const { return creditScore; }
 void Loan::setLoanId(const std::string& id) { loanId = id; }
 void Loan::setCustomerId(const std::string& id) { customerId = id; }
 void Loan::setLoanType(const std::string& type) { loanType = type; }
-void Loan::setAmount(double amount) { this->amount = amount; }
-void Loan::setInterestRate(double rate) { interestRate = rate; }
-void Loan::setTermMonths(int months) { termMonths = months; }
-void Loan::setStatus(const std::string& status) { this->status = status; }
+void Loan::setAmount(Money amount) { this->amount = amount; invalidateSchedule(); }
+void Loan::setInterestRate(double rate) { interestRate = rate; invalidateSchedule(); }
+void Loan::setTermMonths(int months) { termMonths = months; invalidateSchedule(); }
+void Loan::setStatus(const std::string& status) { changeStatus(status); }
 void Loan::setDateApproved(const std::string& date) { dateApproved = date; }
-void Loan::setDateDisbursed(const std::string& date) { dateDisbursed = date; }
-void Loan::setMonthlyPayment(double payment) { monthlyPayment = payment; }
-void Loan::setRemainingBalance(double balance) { remainingBalance = balance; }
+void Loan::setDateDisbursed(const std::string& date) { dateDisbursed = date; invalidateSchedule(); }
+void Loan::setMonthlyPayment(Money payment) { monthlyPayment = payment; invalidateSchedule(); }
+void Loan::setRemainingBalance(Money balance) { publishState(status, balance); invalidateSchedule(); }
 void Loan::setDescription(const std::string& description) { this->description = description; }
 void Loan::setCreditScore(double score) { creditScore = score; }
 
+void Loan::setOwner(Customer* owner) {
+    if (this->owner == owner) {
+        return;
+    }
+    if (status == "Active") {
+        if (this->owner) {
+            this->owner->adjustActiveLoans(-1);
+        }
+        if (owner) {
+            owner->adjustActiveLoans(1);
+        }
+    }
+    this->owner = owner;
+}
+
+Customer* Loan::getOwner() const { return owner; }
+
+void Loan::setPaymentLog(LoanPaymentLog* log) { paymentLog = log; }
+
 // Loan management methods
 void Loan::approve() {
-    status = "Approved";
+    changeStatus("Approved");
     dateApproved = getCurrentDateTime();
 }
 
 void Loan::disburse() {
     if (status == "Approved") {
-        status = "Active";
+        publishState("Active", amount);
         dateDisbursed = getCurrentDateTime();
-        remainingBalance = amount;
+        interestPeriods = 0;
+        accruedInterest = Money();
+        invalidateSchedule();
     }
 }
 
-bool Loan::makePayment(double paymentAmount) {
-    if (status != "Active" || paymentAmount <= 0) {
+bool Loan::makePayment(Money paymentAmount) {
+    if (status != "Active" || paymentAmount <= Money()) {
         return false;
     }
     
-    if (paymentAmount >= remainingBalance) {
-        paymentAmount = remainingBalance;
-        status = "Paid";
+    // Interest is charged once per due period, however many payments fall in
+    // it; a payment settles what is owed of it first and the rest retires principal
+    Money interestDue = getInterestDue();
+    int currentPeriod = getCurrentPeriod();
+    if (currentPeriod > interestPeriods) {
+        interestPeriods = currentPeriod;
+    }
+    LoanPayment payment;
+    payment.interest = interestDue > paymentAmount ? paymentAmount : interestDue;
+    accruedInterest = interestDue - payment.interest;
+    payment.principal = paymentAmount - payment.interest;
+    bool paidOff = payment.principal >= remainingBalance;
+    if (paidOff) {
+        payment.principal = remainingBalance; // Overpayment is not taken
     }
     
-    remainingBalance -= paymentAmount;
+    publishState(paidOff ? "Paid" : status, remainingBalance - payment.principal);
+    paidPrincipal += payment.principal;
+    paidInterest += payment.interest;
+    paymentCount++;
+    invalidateSchedule();
     
-    // Create payment transaction
-    auto payment = std::make_shared<Transaction>(
-        customerId, "Loan Payment", -paymentAmount, remainingBalance, getCurrentDateTime(),
-        "Loan payment for " + loanId
-    );
-    addPayment(payment);
+    if (paymentLog) {
+        payment.date = getCurrentDateTime();
+        payment.balanceAfter = remainingBalance;
+        paymentLog->record(loanId, payment);
+    }
+    BankMetrics::shared().loanPayments.add();
     
     return true;
 }
 
+bool Loan::makePayment(double paymentAmount) {
+    return makePayment(Money::fromDouble(paymentAmount));
+}
+
+double Loan::calculateInterestRate(double creditScore, const std::string& loanType) {
+    // Set interest rate based on credit score and loan type
+    double rate;
+    if (creditScore >= 750) {
+        rate = 5.0; // Excellent credit
+    } else if (creditScore >= 700) {
+        rate = 7.0; // Good credit
+    } else if (creditScore >= 650) {
+        rate = 9.0; // Fair credit
+    } else {
+        rate = 12.0; // Poor credit
+    }
+    
+    // Adjust rate based on loan type
+    if (loanType == "Home") {
+        rate -= 1.0; // Lower rate for home loans
+    } else if (loanType == "Education") {
+        rate -= 0.5; // Lower rate for education loans
+    }
+    return rate;
+}
+
 void Loan::calculateMonthlyPayment() {
     if (termMonths > 0 && interestRate > 0) {
-        double monthlyRate = interestRate / 100.0 / 12.0;
-        monthlyPayment = amount * (monthlyRate * pow(1 + monthlyRate, termMonths)) / 
-                        (pow(1 + monthlyRate, termMonths) - 1);
+        // The annuity factor is shared by every loan with the same rate and term
+        monthlyPayment = AmortizationEngine::shared().getMonthlyPayment(amount, interestRate, termMonths);
+        invalidateSchedule();
     }
 }
 
 void Loan::calculateRemainingBalance() {
-    double totalPaid = getTotalPaid();
-    remainingBalance = amount - totalPaid;
-    if (remainingBalance <= 0) {
-        remainingBalance = 0;
-        status = "Paid";
+    Money balance = amount - paidPrincipal;
+    if (balance <= Money()) {
+        publishState("Paid", Money());
+    } else {
+        publishState(status, balance);
     }
 }
 
-double Loan::getTotalPaid() const {
-    double total = 0.0;
-    for (const auto& payment : payments) {
-        total += std::abs(payment->getAmount());
-    }
-    return total;
+Money Loan::getTotalPaid() const {
+    return paidPrincipal + paidInterest;
+}
+
+Money Loan::getPaidPrincipal() const {
+    return paidPrincipal;
+}
+
+Money Loan::getPaidInterest() const {
+    return paidInterest;
 }
 
 int Loan::getPaymentsMade() const {
-    return payments.size();
+    return paymentCount;
+}
+
+int Loan::getPeriodsCovered() const {
+    return AmortizationEngine::shared().getPeriodsCovered(amount, interestRate, termMonths, monthlyPayment,
+                                                          remainingBalance);
+}
+
+Money Loan::getInterestDue() const {
+    if (status != "Active") {
+        return Money();
+    }
+    // The balance only moves on payments, so every period since the last one charges the same
+    int uncharged = getCurrentPeriod() - interestPeriods;
+    if (uncharged <= 0) {
+        return accruedInterest;
+    }
+    return accruedInterest + remainingBalance.interest(interestRate, 12) * uncharged;
+}
+
+Money Loan::getPayoffAmount() const {
+    return status == "Active" ? remainingBalance + getInterestDue() : Money();
 }
 
 bool Loan::isOverdue() const {
@@ -150,24 +242,91 @@ bool Loan::isOverdue() const {
 }
 
 int Loan::getDaysOverdue() const {
-    // Simplified calculation - in real system, track actual due dates
-    return 0; // Placeholder
+    if (status != "Active") return 0;
+    
+    int days = AmortizationEngine::daysBetween(getNextPaymentDate(), AmortizationEngine::today());
+    return days > 0 ? days : 0;
 }
 
-double Loan::getLateFee() const {
+Money Loan::getLateFee() const {
     if (isOverdue()) {
-        return monthlyPayment * 0.05; // 5% late fee
+        return monthlyPayment.interest(5.0); // 5% late fee
     }
-    return 0.0;
+    return Money();
 }
 
-// Payment management
-void Loan::addPayment(std::shared_ptr<Transaction> payment) {
-    payments.push_back(payment);
+// Amortization
+std::shared_ptr<const AmortizationSchedule> Loan::getSchedule() const {
+    auto current = std::atomic_load(&schedule);
+    if (!current) {
+        // Due dates follow the principal actually retired, not how many payments it took
+        current = AmortizationEngine::shared().buildSchedule(
+            remainingBalance, interestRate, termMonths, getPeriodsCovered(), monthlyPayment, getStartDate());
+        std::atomic_store(&schedule, current);
+    }
+    return current;
+}
+
+void Loan::refreshSchedule() {
+    invalidateSchedule();
+    getSchedule();
+}
+
+void Loan::invalidateSchedule() {
+    std::atomic_store(&schedule, std::shared_ptr<const AmortizationSchedule>());
+}
+
+std::string Loan::getPayoffDate() const {
+    auto plan = getSchedule();
+    if (plan->rows.empty()) {
+        return "N/A";
+    }
+    return plan->getDueDate(plan->rows.back().period);
 }
 
-std::vector<std::shared_ptr<Transaction>> Loan::getPayments() const {
-    return payments;
+Money Loan::getRemainingInterest() const {
+    return getSchedule()->totalInterest;
+}
+
+void Loan::displaySchedule(size_t maxRows) const {
+    auto plan = getSchedule();
+    
+    std::cout << "\n══════════════════════════════════════════════════════════════\n";
+    std::cout << "                    AMORTIZATION SCHEDULE\n";
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+    std::cout << "Loan ID: " << loanId << "\n";
+    std::cout << "Remaining Balance: $" << remainingBalance << "\n";
+    std::cout << "Payoff Amount: $" << getPayoffAmount() << "\n";
+    std::cout << "Remaining Interest: $" << plan->totalInterest << "\n";
+    std::cout << "Payoff Date: " << getPayoffDate() << "\n\n";
+    
+    if (plan->rows.empty()) {
+        std::cout << "Nothing left to repay.\n";
+    } else {
+        std::cout << std::setw(6) << "#" << std::setw(13) << "Due Date" << std::setw(13) << "Payment"
+                  << std::setw(13) << "Interest" << std::setw(13) << "Principal"
+                  << std::setw(14) << "Balance\n";
+        std::cout << std::string(72, '-') << "\n";
+        
+        size_t shown = plan->rows.size() < maxRows ? plan->rows.size() : maxRows;
+        for (size_t i = 0; i < shown; ++i) {
+            const AmortizationRow& row = plan->rows[i];
+            std::cout << std::setw(6) << row.period << std::setw(13) << plan->getDueDate(row.period)
+                      << std::setw(13) << row.payment.toString() << std::setw(13) << row.interest.toString()
+                      << std::setw(13) << row.principal.toString() << std::setw(13) << row.balance.toString()
+                      << "\n";
+        }
+        if (shown < plan->rows.size()) {
+            std::cout << "... " << plan->rows.size() - shown << " more payments\n";
+        }
+    }
+    
+    std::cout << "══════════════════════════════════════════════════════════════\n";
+}
+
+// Payment management
+std::vector<LoanPayment> Loan::getPayments() const {
+    return paymentLog ? paymentLog->getPayments(loanId) : std::vector<LoanPayment>();
 }
 
 void Loan::displayPaymentHistory() const {
@@ -176,22 +335,26 @@ void Loan::displayPaymentHistory() const {
     std::cout << "══════════════════════════════════════════════════════════════\n";
     std::cout << "Loan ID: " << loanId << "\n";
     std::cout << "Loan Type: " << loanType << "\n";
-    std::cout << "Original Amount: $" << std::fixed << std::setprecision(2) << amount << "\n";
-    std::cout << "Remaining Balance: $" << std::fixed << std::setprecision(2) << remainingBalance << "\n";
-    std::cout << "Total Paid: $" << std::fixed << std::setprecision(2) << getTotalPaid() << "\n";
+    std::cout << "Original Amount: $" << amount << "\n";
+    std::cout << "Remaining Balance: $" << remainingBalance << "\n";
+    std::cout << "Total Paid: $" << getTotalPaid() << " (principal $" << paidPrincipal
+              << ", interest $" << paidInterest << ")\n";
     std::cout << "Payments Made: " << getPaymentsMade() << "\n\n";
     
+    auto payments = getPayments();
     if (payments.empty()) {
         std::cout << "No payments recorded.\n";
     } else {
-        std::cout << std::setw(20) << "Date" << std::setw(15) << "Amount" 
-                  << std::setw(15) << "Remaining\n";
-        std::cout << std::string(50, '-') << "\n";
+        std::cout << std::setw(20) << "Date" << std::setw(13) << "Amount" << std::setw(13) << "Principal"
+                  << std::setw(13) << "Interest" << std::setw(14) << "Remaining\n";
+        std::cout << std::string(72, '-') << "\n";
         
         for (const auto& payment : payments) {
-            std::cout << std::setw(20) << payment->getDate()
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << std::abs(payment->getAmount())
-                      << std::setw(15) << "$" << std::fixed << std::setprecision(2) << payment->getBalance() << "\n";
+            std::cout << std::setw(20) << payment.date
+                      << std::setw(13) << payment.getAmount().toString()
+                      << std::setw(13) << payment.principal.toString()
+                      << std::setw(13) << payment.interest.toString()
+                      << std::setw(13) << payment.balanceAfter.toString() << "\n";
         }
     }
     
@@ -200,18 +363,11 @@ void Loan::displayPaymentHistory() const {
 
 // Utility methods
 void Loan::generateLoanId() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(100000, 999999);
-    loanId = "LOAN" + std::to_string(dis(gen));
+    loanId = "LOAN" + std::to_string(IdGenerator::shared().next(100000, 999999));
 }
 
 std::string Loan::getCurrentDateTime() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    return PeriodClock::shared().timestamp();
 }
 
 void Loan::displayInfo() const {
@@ -221,11 +377,11 @@ void Loan::displayInfo() const {
     std::cout << "Loan ID: " << loanId << "\n";
     std::cout << "Customer ID: " << customerId << "\n";
     std::cout << "Loan Type: " << loanType << "\n";
-    std::cout << "Amount: $" << std::fixed << std::setprecision(2) << amount << "\n";
+    std::cout << "Amount: $" << amount << "\n";
     std::cout << "Interest Rate: " << interestRate << "%\n";
     std::cout << "Term: " << termMonths << " months\n";
-    std::cout << "Monthly Payment: $" << std::fixed << std::setprecision(2) << monthlyPayment << "\n";
-    std::cout << "Remaining Balance: $" << std::fixed << std::setprecision(2) << remainingBalance << "\n";
+    std::cout << "Monthly Payment: $" << monthlyPayment << "\n";
+    std::cout << "Remaining Balance: $" << remainingBalance << "\n";
     std::cout << "Status: " << status << "\n";
     std::cout << "Credit Score: " << creditScore << "\n";
     std::cout << "Date Applied: " << dateApplied << "\n";
@@ -235,6 +391,11 @@ void Loan::displayInfo() const {
     if (!dateDisbursed.empty()) {
         std::cout << "Date Disbursed: " << dateDisbursed << "\n";
     }
+    if (status == "Active") {
+        std::cout << "Payoff Amount: $" << getPayoffAmount() << "\n";
+        std::cout << "Next Payment Due: " << getNextPaymentDate() << "\n";
+        std::cout << "Payoff Date: " << getPayoffDate() << "\n";
+    }
     if (!description.empty()) {
         std::cout << "Description: " << description << "\n";
     }
@@ -246,7 +407,9 @@ std::string Loan::toFileString() const {
     oss << loanId << "|" << customerId << "|" << loanType << "|" << amount << "|"
         << interestRate << "|" << termMonths << "|" << status << "|" << dateApplied << "|"
         << dateApproved << "|" << dateDisbursed << "|" << monthlyPayment << "|"
-        << remainingBalance << "|" << description << "|" << creditScore;
+        << remainingBalance << "|" << description << "|" << creditScore << "|"
+        << paidPrincipal << "|" << paidInterest << "|" << paymentCount << "|"
+        << interestPeriods << "|" << accruedInterest;
     return oss.str();
 }
 
@@ -263,31 +426,110 @@ void Loan::fromFileString(const std::string& data) {
         loanId = tokens[0];
         customerId = tokens[1];
         loanType = tokens[2];
-        amount = std::stod(tokens[3]);
+        amount = Money::parse(tokens[3]);
         interestRate = std::stod(tokens[4]);
         termMonths = std::stoi(tokens[5]);
-        status = tokens[6];
+        publishState(tokens[6], Money::parse(tokens[11]));
         dateApplied = tokens[7];
         dateApproved = tokens[8];
         dateDisbursed = tokens[9];
-        monthlyPayment = std::stod(tokens[10]);
-        remainingBalance = std::stod(tokens[11]);
+        monthlyPayment = Money::parse(tokens[10]);
         description = tokens[12];
         creditScore = std::stod(tokens[13]);
+        if (tokens.size() >= 17) {
+            paidPrincipal = Money::parse(tokens[14]);
+            paidInterest = Money::parse(tokens[15]);
+            paymentCount = std::stoi(tokens[16]);
+            if (tokens.size() >= 19) {
+                interestPeriods = std::stoi(tokens[17]);
+                accruedInterest = Money::parse(tokens[18]);
+            } else {
+                // Older files charged interest per payment, not per period; periods
+                // already behind them are not charged again after the upgrade
+                interestPeriods = std::max(paymentCount, getCurrentPeriod());
+                accruedInterest = Money();
+            }
+        } else {
+            // Files from before running totals: whatever was repaid counts as principal,
+            // and interest starts accruing from the current period
+            paidPrincipal = status == "Active" || status == "Paid" ? amount - remainingBalance : Money();
+            paidInterest = Money();
+            paymentCount = 0;
+            interestPeriods = getCurrentPeriod();
+            accruedInterest = Money();
+        }
+        invalidateSchedule();
     }
 }
 
 bool Loan::isEligible() const {
-    return creditScore >= 600 && amount > 0 && termMonths > 0;
+    return creditScore >= 600 && amount > Money() && termMonths > 0;
 }
 
 double Loan::getLoanToValueRatio() const {
     // Simplified LTV calculation
-    return amount / 100000.0; // Assuming $100k as base value
+    return amount.toDouble() / 100000.0; // Assuming $100k as base value
 }
 
 std::string Loan::getNextPaymentDate() const {
-    // Simplified next payment date calculation
-    // In a real system, you'd track actual payment schedules
-    return "Next payment due: Monthly";
+    if (status != "Active") {
+        return "N/A";
+    }
+    auto plan = getSchedule();
+    if (plan->rows.empty()) {
+        return "N/A";
+    }
+    return plan->getDueDate(plan->rows.front().period);
+}
+
+void Loan::addMemoryUsage(MemoryReport& report) const {
+    report.addShared(MemorySubsystem::Loans, sizeof(Loan));
+    for (const std::string* field : {&loanId, &customerId, &loanType, &status, &dateApplied, &dateApproved,
+                                     &dateDisbursed, &description}) {
+        report.addString(*field);
+    }
+    auto plan = std::atomic_load(&schedule);
+    if (plan) {
+        report.addShared(MemorySubsystem::Loans, sizeof(AmortizationSchedule));
+        report.addString(plan->startDate);
+        report.addVector(MemorySubsystem::Loans, plan->rows);
+    }
+}
+
+// Helper methods
+std::string Loan::getStartDate() const {
+    // The first payment falls due one month after the money went out
+    const std::string& start = !dateDisbursed.empty() ? dateDisbursed
+                      : !dateApproved.empty() ? dateApproved : dateApplied;
+    return start.substr(0, 10);
+}
+
+int Loan::getCurrentPeriod() const {
+    std::string start = getStartDate();
+    std::string today = AmortizationEngine::today();
+    int days = AmortizationEngine::daysBetween(start, today);
+    // No month is longer than 31 days, so this never overshoots the answer
+    int period = days / 31 > 1 ? days / 31 : 1;
+    while (AmortizationEngine::daysBetween(AmortizationEngine::addMonths(start, period), today) > 0) {
+        period++;
+    }
+    return period;
+}
+
+void Loan::changeStatus(const std::string& newStatus) {
+    publishState(newStatus, remainingBalance);
+}
+
+void Loan::publishState(const std::string& newStatus, Money newBalance) {
+    // Keep the owner's active-loan count in step with this loan
+    bool wasActive = status == "Active";
+    bool isActive = newStatus == "Active";
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        status = newStatus;
+        remainingBalance = newBalance;
+    }
+    if (owner && wasActive != isActive) {
+        owner->adjustActiveLoans(isActive ? 1 : -1);
+    }
 }
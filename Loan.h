@@ -5,31 +5,48 @@
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <mutex>
 
-class Transaction;
+#include "Money.h"
+#include "LoanPaymentLog.h"
+
+struct AmortizationSchedule;
+class Customer;
+class MemoryReport;
 
 class Loan {
 private:
     std::string loanId;
     std::string customerId;
     std::string loanType; // "Personal", "Home", "Business", "Education"
-    double amount;
+    Money amount;
     double interestRate;
     int termMonths;
     std::string status; // "Pending", "Approved", "Active", "Paid", "Defaulted"
     std::string dateApplied;
     std::string dateApproved;
     std::string dateDisbursed;
-    double monthlyPayment;
-    double remainingBalance;
-    std::vector<std::shared_ptr<Transaction>> payments;
+    Money monthlyPayment;
+    Money remainingBalance;
+    // Running repayment totals; the itemized history lives in the payment log
+    Money paidPrincipal;
+    Money paidInterest;
+    int paymentCount;
+    int interestPeriods;    // Due periods whose interest has been charged
+    Money accruedInterest;  // Interest charged but not yet paid
+    LoanPaymentLog* paymentLog; // Bank-wide log every payment is recorded to (optional)
     std::string description;
     double creditScore;
+    mutable std::shared_ptr<const AmortizationSchedule> schedule; // Built on demand, dropped on change
+    Customer* owner; // Customer whose active-loan count includes this loan (optional)
+    // Status and remaining balance are read by snapshots while payments post;
+    // they only change together, under this lock
+    mutable std::mutex stateMutex;
 
 public:
     // Constructors
     Loan();
-    Loan(const std::string& customerId, const std::string& loanType, double amount, 
+    Loan(const std::string& customerId, const std::string& loanType, Money amount, 
          int termMonths, double creditScore);
     ~Loan();
 
@@ -38,6 +55,7 @@ public:
     std::string getCustomerId() const;
     std::string getLoanType() const;
     double getAmount() const;
+    Money getAmountMoney() const;
     double getInterestRate() const;
     int getTermMonths() const;
     std::string getStatus() const;
@@ -46,6 +64,9 @@ public:
     std::string getDateDisbursed() const;
     double getMonthlyPayment() const;
     double getRemainingBalance() const;
+    Money getMonthlyPaymentMoney() const;
+    Money getRemainingBalanceMoney() const;
+    void getState(std::string& status, Money& remainingBalance) const; // Both as of the same moment
     std::string getDescription() const;
     double getCreditScore() const;
 
@@ -53,32 +74,50 @@ public:
     void setLoanId(const std::string& id);
     void setCustomerId(const std::string& id);
     void setLoanType(const std::string& type);
-    void setAmount(double amount);
+    void setAmount(Money amount);
     void setInterestRate(double rate);
     void setTermMonths(int months);
     void setStatus(const std::string& status);
     void setDateApproved(const std::string& date);
     void setDateDisbursed(const std::string& date);
-    void setMonthlyPayment(double payment);
-    void setRemainingBalance(double balance);
+    void setMonthlyPayment(Money payment);
+    void setRemainingBalance(Money balance);
     void setDescription(const std::string& description);
     void setCreditScore(double score);
+    void setOwner(Customer* owner); // Moves an Active loan's count from the old owner to the new
+    void setPaymentLog(LoanPaymentLog* log);
+    Customer* getOwner() const;
 
     // Loan management methods
     void approve();
     void disburse();
+    bool makePayment(Money amount);
     bool makePayment(double amount);
     void calculateMonthlyPayment();
+    static double calculateInterestRate(double creditScore, const std::string& loanType);
     void calculateRemainingBalance();
-    double getTotalPaid() const;
+    Money getTotalPaid() const;
+    Money getPaidPrincipal() const;
+    Money getPaidInterest() const;
     int getPaymentsMade() const;
+    int getPeriodsCovered() const; // Scheduled payments the principal retired so far covers
+    Money getInterestDue() const;  // Unpaid interest, including periods that fell due since the last payment
+    Money getPayoffAmount() const; // Pays the loan off today
     bool isOverdue() const;
     int getDaysOverdue() const;
-    double getLateFee() const;
+    Money getLateFee() const;
+
+    // Amortization
+    std::shared_ptr<const AmortizationSchedule> getSchedule() const;
+    void refreshSchedule();
+    void invalidateSchedule();
+    std::string getPayoffDate() const;
+    Money getRemainingInterest() const;
+    void displaySchedule(size_t maxRows = 12) const;
 
     // Payment management
-    void addPayment(std::shared_ptr<Transaction> payment);
-    std::vector<std::shared_ptr<Transaction>> getPayments() const;
+    std::vector<LoanPayment> getPayments() const; // Reads the payment log
+
     void displayPaymentHistory() const;
 
     // Utility methods
@@ -90,6 +129,13 @@ public:
     bool isEligible() const;
     double getLoanToValueRatio() const;
     std::string getNextPaymentDate() const;
+    void addMemoryUsage(MemoryReport& report) const; // Includes the cached schedule
+
+private:
+    void changeStatus(const std::string& newStatus);
+    void publishState(const std::string& newStatus, Money newBalance);
+    std::string getStartDate() const; // Period n falls due n months after this
+    int getCurrentPeriod() const;     // First period whose due date is today or later
 };
 
 #endif // LOAN_H
@@ -0,0 +1,195 @@
+#include "LoanAnalytics.h"
+#include "Loan.h"
+#include "LedgerStatistics.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+const char* const kTypeLabels[] = {"Personal", "Home", "Business", "Education", "Other"};
+const char* const kBandLabels[] = {"Below 600", "600-649", "650-699", "700-749", "750+"};
+const char* const kTermLabels[] = {"Up to 12 months", "13-36 months", "37-60 months", "61-120 months", "Over 120 months"};
+
+const size_t kMinBlockSize = 16384;
+
+const int kMaxGroups = 8;
+
+// Per-block partial sums, one slot per group
+struct Partial {
+    size_t count[kMaxGroups] = {};
+    int64_t principal[kMaxGroups] = {};
+    int64_t remaining[kMaxGroups] = {};
+    int64_t inflow[kMaxGroups] = {};
+    __int128 rateByRemaining[kMaxGroups] = {};
+    __int128 rateByPrincipal[kMaxGroups] = {};
+};
+
+} // namespace
+
+LoanAnalytics::LoanAnalytics(const LedgerSnapshot& snapshot, uint64_t version, ThreadPool& pool)
+    : version(version) {
+    size_t count = snapshot.loans.size();
+    typeCodes.resize(count);
+    statusCodes.resize(count);
+    bandCodes.resize(count);
+    termCodes.resize(count);
+    principalCents.resize(count);
+    remainingCents.resize(count);
+    paymentCents.resize(count);
+    rateMicros.resize(count);
+
+    // Mutable fields come from the snapshot row, identity fields from the loan itself
+    pool.parallelFor(0, count, kMinBlockSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const LedgerSnapshot::LoanRow& row = snapshot.loans[i];
+            typeCodes[i] = typeCode(row.loan->getLoanType());
+            statusCodes[i] = statusCode(row.status);
+            bandCodes[i] = bandCode(row.loan->getCreditScore());
+            termCodes[i] = termCode(row.loan->getTermMonths());
+            principalCents[i] = row.loan->getAmountMoney().getCents();
+            remainingCents[i] = row.remainingBalance.getCents();
+            paymentCents[i] = row.loan->getMonthlyPaymentMoney().getCents();
+            rateMicros[i] = Money::rateToMicros(row.loan->getInterestRate());
+        }
+    });
+}
+
+// Queries
+std::vector<LoanGroupStats> LoanAnalytics::aggregate(LoanDimension dimension, ThreadPool& pool) const {
+    const std::vector<uint8_t>& codes = *codesFor(dimension);
+    const uint8_t activeCode = statusCode("Active");
+    size_t count = size();
+
+    // A few blocks per worker so stealing can even out the load
+    size_t blockCount = std::min(pool.getThreadCount() * 4, (count + kMinBlockSize - 1) / kMinBlockSize);
+    blockCount = std::max<size_t>(blockCount, 1);
+    size_t blockSize = (count + blockCount - 1) / blockCount;
+    std::vector<Partial> partials(blockCount);
+
+    pool.parallelFor(0, blockCount, 1, [&](size_t firstBlock, size_t lastBlock) {
+        for (size_t block = firstBlock; block < lastBlock; ++block) {
+            Partial& partial = partials[block];
+            size_t end = std::min(count, (block + 1) * blockSize);
+            for (size_t i = block * blockSize; i < end; ++i) {
+                uint8_t group = codes[i];
+                partial.count[group]++;
+                partial.principal[group] += principalCents[i];
+                partial.remaining[group] += remainingCents[i];
+                partial.rateByRemaining[group] += static_cast<__int128>(remainingCents[i]) * rateMicros[i];
+                partial.rateByPrincipal[group] += static_cast<__int128>(principalCents[i]) * rateMicros[i];
+                if (statusCodes[i] == activeCode) {
+                    partial.inflow[group] += paymentCents[i];
+                }
+            }
+        }
+    });
+
+    // Merge the partials and keep the groups that have loans
+    std::vector<LoanGroupStats> groups;
+    for (int group = 0; group < groupCount(dimension); ++group) {
+        size_t loans = 0;
+        int64_t principal = 0, remaining = 0, inflow = 0;
+        __int128 rateByRemaining = 0, rateByPrincipal = 0;
+        for (const Partial& partial : partials) {
+            loans += partial.count[group];
+            principal += partial.principal[group];
+            remaining += partial.remaining[group];
+            inflow += partial.inflow[group];
+            rateByRemaining += partial.rateByRemaining[group];
+            rateByPrincipal += partial.rateByPrincipal[group];
+        }
+        if (loans == 0) {
+            continue;
+        }
+
+        LoanGroupStats stats;
+        stats.label = groupLabel(dimension, group);
+        stats.count = loans;
+        stats.principal = Money::fromCents(principal);
+        stats.remaining = Money::fromCents(remaining);
+        stats.monthlyInflow = Money::fromCents(inflow);
+        if (remaining > 0) {
+            stats.weightedRate = static_cast<double>(rateByRemaining) / remaining / 1e6;
+        } else if (principal > 0) {
+            stats.weightedRate = static_cast<double>(rateByPrincipal) / principal / 1e6;
+        } else {
+            stats.weightedRate = 0.0;
+        }
+        groups.push_back(stats);
+    }
+    return groups;
+}
+
+size_t LoanAnalytics::size() const {
+    return principalCents.size();
+}
+
+uint64_t LoanAnalytics::getVersion() const {
+    return version;
+}
+
+const char* LoanAnalytics::dimensionName(LoanDimension dimension) {
+    switch (dimension) {
+        case LoanDimension::LoanType: return "Loan type";
+        case LoanDimension::Status: return "Status";
+        case LoanDimension::CreditBand: return "Credit score band";
+        case LoanDimension::TermBucket: return "Term";
+    }
+    return "Unknown";
+}
+
+// Helper methods
+const std::vector<uint8_t>* LoanAnalytics::codesFor(LoanDimension dimension) const {
+    switch (dimension) {
+        case LoanDimension::LoanType: return &typeCodes;
+        case LoanDimension::Status: return &statusCodes;
+        case LoanDimension::CreditBand: return &bandCodes;
+        case LoanDimension::TermBucket: return &termCodes;
+    }
+    return &statusCodes;
+}
+
+int LoanAnalytics::groupCount(LoanDimension dimension) {
+    return dimension == LoanDimension::Status ? LedgerTotals::kLoanStatusCount + 1 : 5;
+}
+
+const char* LoanAnalytics::groupLabel(LoanDimension dimension, int code) {
+    switch (dimension) {
+        case LoanDimension::LoanType: return kTypeLabels[code];
+        case LoanDimension::Status:
+            return code < LedgerTotals::kLoanStatusCount ? LedgerStatistics::loanStatusName(code) : "Other";
+        case LoanDimension::CreditBand: return kBandLabels[code];
+        case LoanDimension::TermBucket: return kTermLabels[code];
+    }
+    return "Other";
+}
+
+uint8_t LoanAnalytics::typeCode(const std::string& loanType) {
+    for (uint8_t code = 0; code < 4; ++code) {
+        if (loanType == kTypeLabels[code]) {
+            return code;
+        }
+    }
+    return 4;
+}
+
+uint8_t LoanAnalytics::statusCode(const std::string& status) {
+    int index = LedgerStatistics::loanStatusIndex(status);
+    return static_cast<uint8_t>(index >= 0 ? index : LedgerTotals::kLoanStatusCount);
+}
+
+uint8_t LoanAnalytics::bandCode(double creditScore) {
+    if (creditScore < 600.0) return 0;
+    if (creditScore < 650.0) return 1;
+    if (creditScore < 700.0) return 2;
+    if (creditScore < 750.0) return 3;
+    return 4;
+}
+
+uint8_t LoanAnalytics::termCode(int termMonths) {
+    if (termMonths <= 12) return 0;
+    if (termMonths <= 36) return 1;
+    if (termMonths <= 60) return 2;
+    if (termMonths <= 120) return 3;
+    return 4;
+}
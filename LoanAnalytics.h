@@ -0,0 +1,71 @@
+#ifndef LOAN_ANALYTICS_H
+#define LOAN_ANALYTICS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Money.h"
+#include "LedgerSnapshot.h"
+
+class ThreadPool;
+
+// Ways to slice the loan book
+enum class LoanDimension {
+    LoanType,
+    Status,
+    CreditBand,
+    TermBucket
+};
+
+// Aggregates for one slice of the loan book
+struct LoanGroupStats {
+    std::string label;
+    size_t count;
+    Money principal;
+    Money remaining;
+    double weightedRate;  // Annual rate (%) weighted by remaining balance, or by principal once repaid
+    Money monthlyInflow;  // Scheduled payments due from Active loans
+};
+
+// Column store of the loan book for portfolio analytics.
+//
+// Every loan becomes one row of small integer codes and integer cents, so
+// a breakdown is a linear scan over a few flat arrays. Scans are split
+// into blocks that reduce into private partials on the thread pool and
+// are merged at the end; sums are exact integers, so the result does not
+// depend on how the work was split.
+class LoanAnalytics {
+private:
+    uint64_t version; // Loan book version the columns were built at
+    std::vector<uint8_t> typeCodes;
+    std::vector<uint8_t> statusCodes;
+    std::vector<uint8_t> bandCodes;
+    std::vector<uint8_t> termCodes;
+    std::vector<int64_t> principalCents;
+    std::vector<int64_t> remainingCents;
+    std::vector<int64_t> paymentCents;
+    std::vector<int64_t> rateMicros;
+
+public:
+    // Build the columns from a pinned snapshot of the ledger, taken at or after the given loan book version
+    LoanAnalytics(const LedgerSnapshot& snapshot, uint64_t version, ThreadPool& pool);
+
+    // Queries
+    std::vector<LoanGroupStats> aggregate(LoanDimension dimension, ThreadPool& pool) const;
+    size_t size() const;
+    uint64_t getVersion() const;
+
+    static const char* dimensionName(LoanDimension dimension);
+
+private:
+    const std::vector<uint8_t>* codesFor(LoanDimension dimension) const;
+    static int groupCount(LoanDimension dimension);
+    static const char* groupLabel(LoanDimension dimension, int code);
+    static uint8_t typeCode(const std::string& loanType);
+    static uint8_t statusCode(const std::string& status);
+    static uint8_t bandCode(double creditScore);
+    static uint8_t termCode(int termMonths);
+};
+
+#endif // LOAN_ANALYTICS_H
@@ -0,0 +1,128 @@
+#include "LoanPaymentLog.h"
+#include "MemoryAccounting.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+LoanPaymentLog::LoanPaymentLog() : loaded(false), truncateOnSave(false) {}
+
+// Log operations
+void LoanPaymentLog::open(const std::string& fileName) {
+    std::lock_guard<std::mutex> guard(lock);
+    this->fileName = fileName;
+    loaded = false;
+    history.clear();
+    unsaved.clear();
+    truncateOnSave = false;
+}
+
+void LoanPaymentLog::record(const std::string& loanId, const LoanPayment& payment) {
+    std::lock_guard<std::mutex> guard(lock);
+    unsaved.emplace_back(loanId, payment);
+    if (loaded) {
+        history[loanId].push_back(payment);
+    }
+}
+
+std::vector<LoanPayment> LoanPaymentLog::getPayments(const std::string& loanId) const {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!loaded) {
+        loadLocked();
+    }
+    auto it = history.find(loanId);
+    return it != history.end() ? it->second : std::vector<LoanPayment>();
+}
+
+void LoanPaymentLog::save() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (unsaved.empty() && !truncateOnSave) {
+        return;
+    }
+
+    std::ofstream file(fileName, truncateOnSave ? std::ios::trunc : std::ios::app);
+    if (file.is_open()) {
+        for (const auto& entry : unsaved) {
+            file << toFileString(entry.first, entry.second) << "\n";
+        }
+        file.close();
+        unsaved.clear();
+        truncateOnSave = false;
+    }
+}
+
+void LoanPaymentLog::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    history.clear();
+    unsaved.clear();
+    loaded = true; // Nothing left on file worth reading
+    truncateOnSave = true;
+}
+
+void LoanPaymentLog::addMemoryUsage(MemoryReport& report) const {
+    std::lock_guard<std::mutex> guard(lock);
+    report.addHashMap(MemorySubsystem::Loans, history);
+    for (const auto& entry : history) {
+        report.addVector(MemorySubsystem::Loans, entry.second);
+        for (const auto& payment : entry.second) {
+            report.addString(payment.date);
+        }
+    }
+    report.addVector(MemorySubsystem::Loans, unsaved);
+    for (const auto& entry : unsaved) {
+        report.addString(entry.first);
+        report.addString(entry.second.date);
+    }
+}
+
+// Serialization
+std::string LoanPaymentLog::toFileString(const std::string& loanId, const LoanPayment& payment) {
+    std::ostringstream oss;
+    oss << loanId << "|" << payment.date << "|" << payment.principal << "|"
+        << payment.interest << "|" << payment.balanceAfter;
+    return oss.str();
+}
+
+bool LoanPaymentLog::fromFileString(const std::string& data, std::string& loanId, LoanPayment& payment) {
+    std::istringstream iss(data);
+    std::string token;
+    std::vector<std::string> tokens;
+
+    while (std::getline(iss, token, '|')) {
+        tokens.push_back(token);
+    }
+
+    if (tokens.size() < 5) {
+        return false;
+    }
+    try {
+        loanId = tokens[0];
+        payment.date = tokens[1];
+        payment.principal = Money::parse(tokens[2]);
+        payment.interest = Money::parse(tokens[3]);
+        payment.balanceAfter = Money::parse(tokens[4]);
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+    return true;
+}
+
+// Helper methods
+void LoanPaymentLog::loadLocked() const {
+    // Payments recorded before the first read are still unsaved, so add them after the file
+    std::ifstream file(fileName);
+    if (file.is_open()) {
+        std::string line;
+        std::string loanId;
+        LoanPayment payment;
+        while (std::getline(file, line)) {
+            if (fromFileString(line, loanId, payment)) {
+                history[loanId].push_back(payment);
+            }
+        }
+        file.close();
+    }
+    for (const auto& entry : unsaved) {
+        history[entry.first].push_back(entry.second);
+    }
+    loaded = true;
+}
@@ -0,0 +1,61 @@
+#ifndef LOAN_PAYMENT_LOG_H
+#define LOAN_PAYMENT_LOG_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <mutex>
+
+#include "Money.h"
+
+class MemoryReport;
+
+// One repayment, split into the interest it covered and the principal it retired
+struct LoanPayment {
+    std::string date;
+    Money principal;
+    Money interest;
+    Money balanceAfter;
+
+    Money getAmount() const { return principal + interest; }
+};
+
+// Bank-wide, append-only record of loan repayments.
+//
+// Loans keep their own running totals, so the history is only needed when
+// somebody asks to see it. The file is therefore not read at startup: it
+// is parsed on the first history request, and saving only appends the
+// payments recorded since the last save.
+class LoanPaymentLog {
+private:
+    std::string fileName;
+    mutable std::mutex lock;
+    mutable bool loaded;
+    mutable std::unordered_map<std::string, std::vector<LoanPayment>> history;
+    std::vector<std::pair<std::string, LoanPayment>> unsaved;
+    bool truncateOnSave;
+
+public:
+    // Constructor
+    LoanPaymentLog();
+    LoanPaymentLog(const LoanPaymentLog&) = delete;
+    LoanPaymentLog& operator=(const LoanPaymentLog&) = delete;
+
+    // Log operations
+    void open(const std::string& fileName); // Forgets in-memory state; the file is read on demand
+    void record(const std::string& loanId, const LoanPayment& payment);
+    std::vector<LoanPayment> getPayments(const std::string& loanId) const;
+    void save();
+    void clear(); // Empties the log, including the file on the next save
+    void addMemoryUsage(MemoryReport& report) const; // Histories loaded so far and unsaved payments
+
+    // Serialization
+    static std::string toFileString(const std::string& loanId, const LoanPayment& payment);
+    static bool fromFileString(const std::string& data, std::string& loanId, LoanPayment& payment);
+
+private:
+    void loadLocked() const;
+};
+
+#endif // LOAN_PAYMENT_LOG_H
@@ -0,0 +1,97 @@
+#include "MemoryAccounting.h"
+#include <iomanip>
+
+namespace {
+
+// Strings up to this length live inside the std::string object itself
+const size_t kInlineStringCapacity = std::string().capacity();
+
+// Reference counts (and vtable pointer) make_shared puts in front of the object
+const size_t kControlBlockHeader = 2 * sizeof(void*);
+
+} // namespace
+
+// Recording
+void MemoryReport::add(MemorySubsystem subsystem, size_t objects, uint64_t bytes) {
+    MemoryUsage& entry = usage[static_cast<int>(subsystem)];
+    entry.objects += objects;
+    entry.bytes += bytes;
+}
+
+void MemoryReport::addShared(MemorySubsystem subsystem, size_t objectSize) {
+    add(subsystem, 1, objectSize);
+    add(MemorySubsystem::ControlBlocks, 1, allocationSize(kControlBlockHeader + objectSize) - objectSize);
+}
+
+void MemoryReport::addString(const std::string& text) {
+    if (text.capacity() > kInlineStringCapacity) {
+        add(MemorySubsystem::Strings, 1, allocationSize(text.capacity() + 1));
+    }
+}
+
+// Results
+const MemoryUsage& MemoryReport::getUsage(MemorySubsystem subsystem) const {
+    return usage[static_cast<int>(subsystem)];
+}
+
+uint64_t MemoryReport::getTotalBytes() const {
+    uint64_t total = 0;
+    for (const auto& entry : usage) {
+        total += entry.bytes;
+    }
+    return total;
+}
+
+double MemoryReport::getBytesPerTransaction() const {
+    size_t transactions = getUsage(MemorySubsystem::Transactions).objects;
+    return transactions > 0 ? static_cast<double>(getTotalBytes()) / transactions : 0.0;
+}
+
+void MemoryReport::print(std::ostream& out) const {
+    const uint64_t total = getTotalBytes();
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << std::left << std::setw(16) << "Subsystem" << std::right << std::setw(12) << "Objects"
+        << std::setw(12) << "MB" << std::setw(10) << "Share" << std::setw(12) << "Bytes/obj" << "\n";
+    out << std::string(62, '-') << "\n";
+    out << std::fixed;
+    for (int i = 0; i < kSubsystemCount; ++i) {
+        const MemoryUsage& entry = usage[i];
+        out << std::left << std::setw(16) << subsystemName(static_cast<MemorySubsystem>(i)) << std::right
+            << std::setw(12) << entry.objects
+            << std::setw(12) << std::setprecision(2) << entry.bytes / 1048576.0
+            << std::setw(9) << std::setprecision(1) << (total ? 100.0 * entry.bytes / total : 0.0) << "%"
+            << std::setw(12) << std::setprecision(0)
+            << (entry.objects ? static_cast<double>(entry.bytes) / entry.objects : 0.0) << "\n";
+    }
+    out << std::string(62, '-') << "\n";
+    out << std::left << std::setw(28) << "Total" << std::right << std::setw(12) << std::setprecision(2)
+        << total / 1048576.0 << "\n";
+    out << "Memory per transaction: " << std::setprecision(0) << getBytesPerTransaction() << " bytes\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// Helpers
+const char* MemoryReport::subsystemName(MemorySubsystem subsystem) {
+    switch (subsystem) {
+        case MemorySubsystem::Customers: return "Customers";
+        case MemorySubsystem::Accounts: return "Accounts";
+        case MemorySubsystem::Transactions: return "Transactions";
+        case MemorySubsystem::Loans: return "Loans";
+        case MemorySubsystem::Strings: return "Strings";
+        case MemorySubsystem::ControlBlocks: return "Control blocks";
+        case MemorySubsystem::Lists: return "Lists";
+        case MemorySubsystem::Indexes: return "Indexes";
+        case MemorySubsystem::Journal: return "Journal";
+    }
+    return "Unknown";
+}
+
+uint64_t MemoryReport::allocationSize(size_t requested) {
+    // glibc: one size_t of header, rounded up to 16 bytes, 32 bytes minimum
+    const uint64_t chunk = (requested + sizeof(size_t) + 15) & ~uint64_t(15);
+    return chunk < 32 ? 32 : chunk;
+}
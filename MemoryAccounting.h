@@ -0,0 +1,79 @@
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+// Where the bank's memory goes
+enum class MemorySubsystem {
+    Customers,     // Customer objects
+    Accounts,      // Account and SavingsAccount objects
+    Transactions,  // Transaction objects
+    Loans,         // Loan objects, cached amortization schedules and loaded payment histories
+    Strings,       // Heap buffers of strings too long for the inline buffer
+    ControlBlocks, // shared_ptr reference counts and allocator rounding of make_shared blocks
+    Lists,         // Per-account transaction histories and per-customer account/loan lists
+    Indexes,       // The bank's object vectors and lookup hash maps
+    Journal        // Transaction journal chunk table and slots
+};
+
+struct MemoryUsage {
+    size_t objects = 0;
+    uint64_t bytes = 0;
+};
+
+// Estimated heap footprint of the bank, by subsystem.
+//
+// Objects report themselves (addMemoryUsage) rather than being counted by
+// an allocator hook, so the posting path pays nothing; the report is built
+// on demand. Every allocation is charged at what glibc malloc hands out for
+// it (header and 16-byte rounding included), so the totals track resident
+// heap rather than sizeof sums.
+class MemoryReport {
+public:
+    static const int kSubsystemCount = 9;
+
+private:
+    MemoryUsage usage[kSubsystemCount];
+
+public:
+    // Recording
+    void add(MemorySubsystem subsystem, size_t objects, uint64_t bytes);
+    void addShared(MemorySubsystem subsystem, size_t objectSize); // One object built with std::make_shared
+    void addString(const std::string& text);
+
+    template <typename T>
+    void addVector(MemorySubsystem subsystem, const std::vector<T>& items) {
+        if (items.capacity() > 0) {
+            add(subsystem, 0, allocationSize(items.capacity() * sizeof(T)));
+        }
+    }
+
+    // std::unordered_map with std::string keys: bucket array plus one node per
+    // entry (next pointer, key/value pair, cached hash); keys go to Strings
+    template <typename Map>
+    void addHashMap(MemorySubsystem subsystem, const Map& map) {
+        add(subsystem, 0, allocationSize(map.bucket_count() * sizeof(void*)));
+        const uint64_t nodeBytes =
+            allocationSize(sizeof(void*) + sizeof(typename Map::value_type) + sizeof(size_t));
+        add(subsystem, 0, nodeBytes * map.size());
+        for (const auto& entry : map) {
+            addString(entry.first);
+        }
+    }
+
+    // Results
+    const MemoryUsage& getUsage(MemorySubsystem subsystem) const;
+    uint64_t getTotalBytes() const;
+    double getBytesPerTransaction() const; // Whole footprint over the transaction count
+    void print(std::ostream& out) const;
+
+    // Helpers
+    static const char* subsystemName(MemorySubsystem subsystem);
+    static uint64_t allocationSize(size_t requested); // malloc chunk size for a request
+};
+
+#endif // MEMORY_ACCOUNTING_H
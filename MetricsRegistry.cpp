@@ -0,0 +1,160 @@
+#include "MetricsRegistry.h"
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <unordered_map>
+
+// Constructor and destructor
+MetricsRegistry::MetricsRegistry() : exporterStopping(false) {}
+
+MetricsRegistry::~MetricsRegistry() {
+    stopFileExporter();
+}
+
+MetricsRegistry& MetricsRegistry::shared() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+// Registration
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> guard(seriesLock);
+    counters.emplace_back();
+    series.push_back(Series{name, help, labels, Type::Counter, &counters.back(), nullptr, nullptr, nullptr});
+    return counters.back();
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> guard(seriesLock);
+    gauges.emplace_back();
+    series.push_back(Series{name, help, labels, Type::Gauge, nullptr, &gauges.back(), nullptr, nullptr});
+    return gauges.back();
+}
+
+void MetricsRegistry::callback(const std::string& name, const std::string& help, const std::string& labels, Type type,
+                               std::function<double()> read, const void* owner) {
+    std::lock_guard<std::mutex> guard(seriesLock);
+    series.push_back(Series{name, help, labels, type, nullptr, nullptr, std::move(read), owner});
+}
+
+void MetricsRegistry::removeCallbacks(const void* owner) {
+    std::lock_guard<std::mutex> guard(seriesLock);
+    std::vector<Series> kept;
+    for (auto& entry : series) {
+        if (!entry.read || entry.owner != owner) {
+            kept.push_back(std::move(entry));
+        }
+    }
+    series.swap(kept);
+}
+
+// Exposition
+void MetricsRegistry::writePrometheus(std::ostream& out) const {
+    std::lock_guard<std::mutex> guard(seriesLock);
+
+    // Samples of one metric must be contiguous, under a single HELP/TYPE header
+    std::vector<std::string> order;
+    std::unordered_map<std::string, std::vector<const Series*>> byName;
+    for (const auto& entry : series) {
+        auto& samples = byName[entry.name];
+        if (samples.empty()) {
+            order.push_back(entry.name);
+        }
+        samples.push_back(&entry);
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::setprecision(17);
+    for (const auto& name : order) {
+        const auto& samples = byName[name];
+        const Series& first = *samples.front();
+        out << "# HELP " << name << " " << first.help << "\n";
+        out << "# TYPE " << name << " " << (first.type == Type::Counter ? "counter" : "gauge") << "\n";
+        for (const Series* sample : samples) {
+            out << name;
+            if (!sample->labels.empty()) {
+                out << "{" << sample->labels << "}";
+            }
+            out << " ";
+            if (sample->counter) {
+                out << sample->counter->get();
+            } else if (sample->gauge) {
+                out << sample->gauge->get();
+            } else {
+                out << sample->read();
+            }
+            out << "\n";
+        }
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool MetricsRegistry::writeFile(const std::string& path) const {
+    // Scrapers must never see a half-written file
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        writePrometheus(file);
+        if (!file) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+void MetricsRegistry::startFileExporter(const std::string& path, int intervalSeconds) {
+    stopFileExporter();
+    exporterStopping = false;
+    exporter = std::thread([this, path, intervalSeconds]() {
+        std::unique_lock<std::mutex> lock(exporterMutex);
+        while (true) {
+            lock.unlock();
+            writeFile(path);
+            lock.lock();
+            if (exporterWake.wait_for(lock, std::chrono::seconds(intervalSeconds), [this] { return exporterStopping; })) {
+                break;
+            }
+        }
+        lock.unlock();
+        writeFile(path);
+    });
+}
+
+void MetricsRegistry::stopFileExporter() {
+    {
+        std::lock_guard<std::mutex> lock(exporterMutex);
+        exporterStopping = true;
+    }
+    exporterWake.notify_all();
+    if (exporter.joinable()) {
+        exporter.join();
+    }
+}
+
+// BankMetrics
+BankMetrics::BankMetrics(MetricsRegistry& registry)
+    : deposits(registry.counter("oyanib_transactions_total", "Ledger operations posted, by type.", "type=\"deposit\"")),
+      withdrawals(registry.counter("oyanib_transactions_total", "Ledger operations posted, by type.", "type=\"withdrawal\"")),
+      transfers(registry.counter("oyanib_transactions_total", "Ledger operations posted, by type.", "type=\"transfer\"")),
+      interestPostings(registry.counter("oyanib_transactions_total", "Ledger operations posted, by type.", "type=\"interest\"")),
+      loanPayments(registry.counter("oyanib_transactions_total", "Ledger operations posted, by type.", "type=\"loan_payment\"")),
+      declinedDailyLimit(registry.counter("oyanib_withdrawals_declined_total",
+                                          "Withdrawals and outgoing transfers declined, by reason.", "reason=\"daily_limit\"")),
+      declinedMonthlyLimit(registry.counter("oyanib_withdrawals_declined_total",
+                                            "Withdrawals and outgoing transfers declined, by reason.", "reason=\"monthly_limit\"")),
+      declinedMinimumBalance(registry.counter("oyanib_withdrawals_declined_total",
+                                              "Withdrawals and outgoing transfers declined, by reason.", "reason=\"minimum_balance\"")),
+      declinedMonthlyCap(registry.counter("oyanib_withdrawals_declined_total",
+                                          "Withdrawals and outgoing transfers declined, by reason.", "reason=\"savings_monthly_cap\"")),
+      activeSessions(registry.gauge("oyanib_server_sessions", "Open server connections.")),
+      requests(registry.counter("oyanib_server_requests_total", "Server protocol requests handled.")) {}
+
+BankMetrics& BankMetrics::shared() {
+    static BankMetrics metrics(MetricsRegistry::shared());
+    return metrics;
+}
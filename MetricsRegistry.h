@@ -0,0 +1,114 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Monotonic count, bumped on the hot path with one relaxed add
+class MetricCounter {
+private:
+    std::atomic<uint64_t> value{0};
+
+public:
+    void add(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// Value that goes up and down
+class MetricGauge {
+private:
+    std::atomic<int64_t> value{0};
+
+public:
+    void add(int64_t amount) { value.fetch_add(amount, std::memory_order_relaxed); }
+    void set(int64_t amount) { value.store(amount, std::memory_order_relaxed); }
+    int64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// Process-wide metrics in Prometheus text exposition format.
+//
+// Counters and gauges are registered once and then updated lock-free by
+// whoever owns them; values that already exist elsewhere (ledger totals,
+// journal size) are registered as callbacks read at scrape time. Callbacks
+// must only read atomics, so a scrape never waits on the ledger. The
+// registry's own lock guards just the list of series.
+class MetricsRegistry {
+public:
+    enum class Type { Counter, Gauge };
+
+private:
+    struct Series {
+        std::string name;
+        std::string help;
+        std::string labels; // Rendered label set, e.g. type="deposit"; empty for none
+        Type type;
+        const MetricCounter* counter;
+        const MetricGauge* gauge;
+        std::function<double()> read;
+        const void* owner; // Callback series are removed with their owner
+    };
+
+    mutable std::mutex seriesLock;
+    std::deque<MetricCounter> counters; // Deques keep references stable as they grow
+    std::deque<MetricGauge> gauges;
+    std::vector<Series> series;
+
+    // Periodic file export
+    std::thread exporter;
+    std::mutex exporterMutex;
+    std::condition_variable exporterWake;
+    bool exporterStopping;
+
+public:
+    // Constructor and destructor
+    MetricsRegistry();
+    ~MetricsRegistry();
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // Process-wide registry
+    static MetricsRegistry& shared();
+
+    // Registration
+    MetricCounter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricGauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    void callback(const std::string& name, const std::string& help, const std::string& labels, Type type,
+                  std::function<double()> read, const void* owner);
+    void removeCallbacks(const void* owner);
+
+    // Exposition
+    void writePrometheus(std::ostream& out) const;
+    bool writeFile(const std::string& path) const; // Written beside the target, then renamed over it
+    void startFileExporter(const std::string& path, int intervalSeconds);
+    void stopFileExporter(); // Writes the file one last time
+};
+
+// The bank's hot-path metrics, registered once in the shared registry
+struct BankMetrics {
+    MetricCounter& deposits;
+    MetricCounter& withdrawals;
+    MetricCounter& transfers;
+    MetricCounter& interestPostings;
+    MetricCounter& loanPayments;
+    MetricCounter& declinedDailyLimit;
+    MetricCounter& declinedMonthlyLimit;
+    MetricCounter& declinedMinimumBalance;
+    MetricCounter& declinedMonthlyCap; // SavingsAccount transactions per month
+    MetricGauge& activeSessions;
+    MetricCounter& requests;
+
+    static BankMetrics& shared();
+
+private:
+    explicit BankMetrics(MetricsRegistry& registry);
+};
+
+#endif // METRICS_REGISTRY_H
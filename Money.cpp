@@ -0,0 +1,119 @@
+#include "Money.h"
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+
+Money Money::fromDouble(double amount) {
+    return Money(std::llround(amount * 100.0));
+}
+
+Money Money::parse(const std::string& text) {
+    // Plain decimal text is read digit by digit so no binary rounding creeps in
+    size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+
+    int64_t whole = 0;
+    size_t wholeDigits = 0;
+    while (i < text.size() && text[i] >= '0' && text[i] <= '9' && wholeDigits < 16) {
+        whole = whole * 10 + (text[i] - '0');
+        ++i;
+        ++wholeDigits;
+    }
+
+    int64_t fraction = 0;
+    size_t fractionDigits = 0;
+    bool roundUp = false;
+    if (i < text.size() && text[i] == '.') {
+        ++i;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+            if (fractionDigits < 2) {
+                fraction = fraction * 10 + (text[i] - '0');
+            } else if (fractionDigits == 2) {
+                roundUp = text[i] >= '5';
+            }
+            ++i;
+            ++fractionDigits;
+        }
+    }
+
+    if (i != text.size() || (wholeDigits == 0 && fractionDigits == 0)) {
+        // Exponents and other forms older files may contain go through double
+        return fromDouble(std::stod(text));
+    }
+
+    if (fractionDigits == 1) {
+        fraction *= 10;
+    }
+    int64_t cents = whole * 100 + fraction + (roundUp ? 1 : 0);
+    return Money(negative ? -cents : cents);
+}
+
+// Conversions
+double Money::toDouble() const {
+    return static_cast<double>(cents) / 100.0;
+}
+
+std::string Money::toString() const {
+    uint64_t magnitude = cents < 0 ? 0 - static_cast<uint64_t>(cents) : static_cast<uint64_t>(cents);
+    std::string fraction = std::to_string(magnitude % 100);
+    if (fraction.size() < 2) {
+        fraction.insert(0, 1, '0');
+    }
+    return (cents < 0 ? "-" : "") + std::to_string(magnitude / 100) + "." + fraction;
+}
+
+Money Money::interest(double annualRatePercent, int periodsPerYear) const {
+    return interestAtMicros(rateToMicros(annualRatePercent), periodsPerYear);
+}
+
+int64_t Money::rateToMicros(double ratePercent) {
+    return std::llround(ratePercent * 1e6);
+}
+
+Money Money::interestAtMicros(int64_t rate, int periodsPerYear) const {
+    if (periodsPerYear <= 0) {
+        periodsPerYear = 1;
+    }
+
+    // Rates are fixed to millionths of a percent, then the product is
+    // divided exactly and rounded half to even
+    int64_t denominator64 = INT64_C(100000000) * periodsPerYear;
+    int64_t product = 0;
+    if (!__builtin_mul_overflow(cents, rate, &product)) {
+        int64_t quotient = product / denominator64;
+        int64_t remainder = product % denominator64;
+        int64_t twiceRemainder = (remainder < 0 ? -remainder : remainder) * 2;
+        if (twiceRemainder > denominator64 || (twiceRemainder == denominator64 && (quotient & 1) != 0)) {
+            quotient += product < 0 ? -1 : 1;
+        }
+        return Money(quotient);
+    }
+
+    // Balances beyond roughly $900M at 100% need the full 128-bit product
+    __int128 numerator = static_cast<__int128>(cents) * rate;
+    __int128 denominator = denominator64;
+
+    __int128 quotient = numerator / denominator;
+    __int128 remainder = numerator % denominator;
+    __int128 twiceRemainder = (remainder < 0 ? -remainder : remainder) * 2;
+    if (twiceRemainder > denominator || (twiceRemainder == denominator && (quotient & 1) != 0)) {
+        quotient += numerator < 0 ? -1 : 1;
+    }
+    return Money(static_cast<int64_t>(quotient));
+}
+
+Money Money::sum(const Money* values, size_t count) {
+    int64_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += values[i].cents;
+    }
+    return Money(total);
+}
+
+std::ostream& operator<<(std::ostream& os, Money amount) {
+    return os << amount.toString();
+}
@@ -0,0 +1,63 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <iosfwd>
+
+// Amount of money as a 64-bit count of cents.
+//
+// Ledger arithmetic on Money is exact. Rounding happens in exactly two
+// places: converting from double (to the nearest cent, halves away from
+// zero) and computing interest (to the nearest cent, halves to even, so
+// that millions of postings don't drift in one direction).
+class Money {
+private:
+    int64_t cents;
+
+    constexpr explicit Money(int64_t cents) : cents(cents) {}
+
+public:
+    // Constructors
+    constexpr Money() : cents(0) {}
+    static constexpr Money fromCents(int64_t cents) { return Money(cents); }
+    static Money fromDouble(double amount);
+    static Money parse(const std::string& text); // Exact for "1234.56"; throws std::invalid_argument
+
+    // Conversions
+    constexpr int64_t getCents() const { return cents; }
+    double toDouble() const;
+    std::string toString() const; // Always two decimals, no exponent
+
+    // Interest on this amount at an annual percentage rate, for one of
+    // periodsPerYear periods, rounded half to even
+    Money interest(double annualRatePercent, int periodsPerYear = 1) const;
+    Money interestAtMicros(int64_t rateMicros, int periodsPerYear = 1) const;
+    static int64_t rateToMicros(double ratePercent); // Millionths of a percent
+    constexpr Money abs() const { return Money(cents < 0 ? -cents : cents); }
+
+    // Integer reduction over a contiguous column of amounts (vectorizes)
+    static Money sum(const Money* values, size_t count);
+
+    // Arithmetic
+    constexpr Money operator+(Money other) const { return Money(cents + other.cents); }
+    constexpr Money operator-(Money other) const { return Money(cents - other.cents); }
+    constexpr Money operator-() const { return Money(-cents); }
+    constexpr Money operator*(int64_t factor) const { return Money(cents * factor); }
+    Money& operator+=(Money other) { cents += other.cents; return *this; }
+    Money& operator-=(Money other) { cents -= other.cents; return *this; }
+
+    // Comparison
+    constexpr bool operator==(Money other) const { return cents == other.cents; }
+    constexpr bool operator!=(Money other) const { return cents != other.cents; }
+    constexpr bool operator<(Money other) const { return cents < other.cents; }
+    constexpr bool operator<=(Money other) const { return cents <= other.cents; }
+    constexpr bool operator>(Money other) const { return cents > other.cents; }
+    constexpr bool operator>=(Money other) const { return cents >= other.cents; }
+};
+
+// Writes the amount with two decimals, independent of the stream's float flags
+std::ostream& operator<<(std::ostream& os, Money amount);
+
+#endif // MONEY_H
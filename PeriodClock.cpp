@@ -0,0 +1,118 @@
+#include "PeriodClock.h"
+#include <ctime>
+#include <cstdio>
+
+namespace {
+
+std::tm localTime(std::time_t now) {
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    return local;
+}
+
+long long localDayNumber(const std::tm& local) {
+    return PeriodClock::daysFromCivil(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1),
+                                      static_cast<unsigned>(local.tm_mday));
+}
+
+} // namespace
+
+PeriodClock::PeriodClock() : virtualSeconds(-1) {
+    std::tm local = localTime(currentTime());
+    dayNumber.store(localDayNumber(local));
+    monthNumber.store((local.tm_year + 1900) * 12LL + local.tm_mon);
+}
+
+PeriodClock& PeriodClock::shared() {
+    static PeriodClock clock;
+    return clock;
+}
+
+// Current periods
+long long PeriodClock::getDayNumber() const {
+    return dayNumber.load(std::memory_order_relaxed);
+}
+
+long long PeriodClock::getMonthNumber() const {
+    return monthNumber.load(std::memory_order_relaxed);
+}
+
+// Period changes
+bool PeriodClock::advance() {
+    std::tm local = localTime(currentTime());
+    long long today = localDayNumber(local);
+    if (today == dayNumber.load()) {
+        return false;
+    }
+    // Month first: a reader that sees the new day never sees the old month
+    monthNumber.store((local.tm_year + 1900) * 12LL + local.tm_mon);
+    dayNumber.store(today);
+    return true;
+}
+
+void PeriodClock::set(long long dayNumber, long long monthNumber) {
+    this->monthNumber.store(monthNumber);
+    this->dayNumber.store(dayNumber);
+}
+
+// Timestamps
+std::string PeriodClock::timestamp() const {
+    std::tm local = localTime(currentTime());
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    return buffer;
+}
+
+void PeriodClock::setVirtualTime(long long epochSeconds) {
+    virtualSeconds.store(epochSeconds);
+    advance();
+}
+
+void PeriodClock::useWallClock() {
+    virtualSeconds.store(-1);
+    advance();
+}
+
+bool PeriodClock::isVirtual() const {
+    return virtualSeconds.load() >= 0;
+}
+
+long long PeriodClock::currentTime() const {
+    long long seconds = virtualSeconds.load(std::memory_order_relaxed);
+    return seconds < 0 ? static_cast<long long>(std::time(nullptr)) : seconds;
+}
+
+// Calendar helpers
+long long PeriodClock::daysFromCivil(long long year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<long long>(dayOfEra) - 719468;
+}
+
+std::string PeriodClock::dateFromDays(long long days) {
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned mp = (5 * dayOfYear + 2) / 153;
+    const unsigned day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    const long long year = static_cast<long long>(yearOfEra) + era * 400 + (month <= 2);
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u", year, month, day);
+    return buffer;
+}
+
+long long PeriodClock::secondsUntilMidnight() {
+    std::tm local = localTime(shared().currentTime());
+    return 86400 - (local.tm_hour * 3600LL + local.tm_min * 60LL + local.tm_sec);
+}
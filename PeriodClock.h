@@ -0,0 +1,56 @@
+#ifndef PERIOD_CLOCK_H
+#define PERIOD_CLOCK_H
+
+#include <atomic>
+#include <string>
+
+// Current day and month as plain numbers for the posting hot path.
+//
+// Finding today's date means a localtime call and a timezone lookup, which
+// used to happen twice on every withdrawal. The clock instead publishes the
+// day (days since 1970-01-01) and the month (year * 12 + month - 1) as
+// atomics; the rollover scheduler advances them at local midnight, so a
+// limit check is just a load and an integer compare.
+//
+// It is also the bank's source of timestamps. A workload replay switches it
+// to a virtual time that the replayer moves along the recording, so every
+// date written during the replay is reproducible.
+class PeriodClock {
+private:
+    std::atomic<long long> dayNumber;
+    std::atomic<long long> monthNumber;
+    std::atomic<long long> virtualSeconds; // Seconds since the epoch; -1 follows the wall clock
+
+public:
+    // Constructor
+    PeriodClock(); // Starts at the local date
+    PeriodClock(const PeriodClock&) = delete;
+    PeriodClock& operator=(const PeriodClock&) = delete;
+
+    // Process-wide clock used by all accounts
+    static PeriodClock& shared();
+
+    // Current periods
+    long long getDayNumber() const;
+    long long getMonthNumber() const;
+
+    // Period changes
+    bool advance(); // Re-reads the local date; true if the day changed
+    void set(long long dayNumber, long long monthNumber);
+
+    // Timestamps
+    std::string timestamp() const; // "YYYY-MM-DD HH:MM:SS", local time
+    void setVirtualTime(long long epochSeconds); // Also moves the day and month
+    void useWallClock();
+    bool isVirtual() const;
+
+    // Calendar helpers
+    static long long daysFromCivil(long long year, unsigned month, unsigned day);
+    static std::string dateFromDays(long long days); // "YYYY-MM-DD"
+    static long long secondsUntilMidnight();
+
+private:
+    long long currentTime() const; // Seconds since the epoch, virtual or wall
+};
+
+#endif // PERIOD_CLOCK_H
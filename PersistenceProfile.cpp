@@ -0,0 +1,95 @@
+#include "PersistenceProfile.h"
+#include <iomanip>
+
+// FileProfile
+double FileProfile::getSeconds() const {
+    double seconds = 0.0;
+    for (double phase : phaseSeconds) {
+        seconds += phase;
+    }
+    return seconds;
+}
+
+double FileProfile::getRecordsPerSecond() const {
+    double seconds = getSeconds();
+    return seconds > 0.0 ? static_cast<double>(records) / seconds : 0.0;
+}
+
+// PersistenceProfile
+uint64_t PersistenceProfile::getBytes() const {
+    uint64_t bytes = 0;
+    for (const auto& file : files) {
+        bytes += file.bytes;
+    }
+    return bytes;
+}
+
+size_t PersistenceProfile::getRecords() const {
+    size_t records = 0;
+    for (const auto& file : files) {
+        records += file.records;
+    }
+    return records;
+}
+
+double PersistenceProfile::getPhaseSeconds(PersistencePhase phase) const {
+    double seconds = 0.0;
+    for (const auto& file : files) {
+        seconds += file.phaseSeconds[static_cast<int>(phase)];
+    }
+    return seconds;
+}
+
+void PersistenceProfile::print(std::ostream& out) const {
+    // Loads and saves go through different phases; show only the ones that ran
+    std::vector<PersistencePhase> phases;
+    for (int i = 0; i < FileProfile::kPhaseCount; ++i) {
+        if (getPhaseSeconds(static_cast<PersistencePhase>(i)) > 0.0) {
+            phases.push_back(static_cast<PersistencePhase>(i));
+        }
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << operation << " data: " << getRecords() << " records, " << std::setprecision(1)
+        << getBytes() / 1048576.0 << " MB in " << std::setprecision(3) << wallSeconds << "s\n";
+    out << std::left << std::setw(20) << "File" << std::right << std::setw(11) << "Records" << std::setw(9) << "MB";
+    for (PersistencePhase phase : phases) {
+        out << std::setw(11) << phaseName(phase);
+    }
+    out << std::setw(9) << "Total" << std::setw(12) << "Records/s" << "\n";
+    out << std::string(61 + 11 * phases.size(), '-') << "\n";
+    for (const auto& file : files) {
+        out << std::left << std::setw(20) << file.fileName << std::right << std::setw(11) << file.records
+            << std::setw(9) << std::setprecision(1) << file.bytes / 1048576.0 << std::setprecision(3);
+        for (PersistencePhase phase : phases) {
+            out << std::setw(11) << file.phaseSeconds[static_cast<int>(phase)];
+        }
+        out << std::setw(9) << file.getSeconds() << std::setw(12) << std::setprecision(0)
+            << file.getRecordsPerSecond() << std::setprecision(3) << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+const char* PersistenceProfile::phaseName(PersistencePhase phase) {
+    switch (phase) {
+        case PersistencePhase::Read: return "Read";
+        case PersistencePhase::Parse: return "Parse";
+        case PersistencePhase::Construct: return "Construct";
+        case PersistencePhase::Index: return "Index";
+        case PersistencePhase::Format: return "Format";
+        case PersistencePhase::Write: return "Write";
+    }
+    return "Unknown";
+}
+
+// PhaseTimer
+PhaseTimer::PhaseTimer(FileProfile& profile) : profile(profile), last(std::chrono::steady_clock::now()) {}
+
+void PhaseTimer::lap(PersistencePhase phase) {
+    auto now = std::chrono::steady_clock::now();
+    profile.phaseSeconds[static_cast<int>(phase)] += std::chrono::duration<double>(now - last).count();
+    last = now;
+}
@@ -0,0 +1,60 @@
+#ifndef PERSISTENCE_PROFILE_H
+#define PERSISTENCE_PROFILE_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+
+// Where load and save time goes for each record
+enum class PersistencePhase {
+    Read,      // Pulling the next line off the file
+    Parse,     // fromFileString: splitting fields and converting numbers
+    Construct, // Allocating the object
+    Index,     // Appending it to the ledger and its totals, and rebuilding lookups
+    Format,    // toFileString
+    Write      // Pushing the line into the file stream
+};
+
+// Timings for one data file
+struct FileProfile {
+    static const int kPhaseCount = 6;
+
+    std::string fileName;
+    uint64_t bytes = 0;
+    size_t records = 0;
+    double phaseSeconds[kPhaseCount] = {};
+
+    double getSeconds() const;
+    double getRecordsPerSecond() const;
+};
+
+// Phase timings for one whole loadData or saveData
+struct PersistenceProfile {
+    std::string operation; // "Load" or "Save"
+    std::string finishedAt;
+    std::vector<FileProfile> files;
+    double wallSeconds = 0.0;
+
+    uint64_t getBytes() const;
+    size_t getRecords() const;
+    double getPhaseSeconds(PersistencePhase phase) const; // Summed over files
+    void print(std::ostream& out) const;
+
+    static const char* phaseName(PersistencePhase phase);
+};
+
+// Lap timer: each lap charges the time since the previous one to a phase,
+// so a record costs one clock read per phase boundary
+class PhaseTimer {
+private:
+    FileProfile& profile;
+    std::chrono::steady_clock::time_point last;
+
+public:
+    explicit PhaseTimer(FileProfile& profile);
+    void lap(PersistencePhase phase);
+};
+
+#endif // PERSISTENCE_PROFILE_H
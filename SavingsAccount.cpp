@@ -1,85 +1,114 @@
 #include "SavingsAccount.h"
+#include "MetricsRegistry.h"
+#include "PeriodClock.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <cstdio>
 
-SavingsAccount::SavingsAccount() : minimumBalance(500.0), monthlyTransactions(0), 
-                                   maxMonthlyTransactions(6), annualInterestRate(2.5) {
+namespace {
+
+// Monthly transaction count, packed like the withdrawal windows: a count from
+// an earlier month reads as zero, whether or not the rollover reset it
+const int kCountPeriodShift = 32;
+const long long kCountMask = (1LL << kCountPeriodShift) - 1;
+
+long long packCount(long long month, long long count) {
+    return (month << kCountPeriodShift) | (count & kCountMask);
+}
+
+long long countMonth(long long packed) {
+    return packed >> kCountPeriodShift;
+}
+
+long long countValue(long long packed) {
+    return packed & kCountMask;
+}
+
+long long currentMonthNumber() {
+    return PeriodClock::shared().getMonthNumber();
+}
+
+// Month numbers are persisted as "YYYY-MM"
+long long parseMonth(const std::string& text) {
+    int year = 0, month = 0;
+    if (std::sscanf(text.c_str(), "%d-%d", &year, &month) != 2) {
+        return 0;
+    }
+    return year * 12LL + (month - 1);
+}
+
+std::string formatMonth(long long month) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%04lld-%02lld", month / 12, month % 12 + 1);
+    return text;
+}
+
+} // namespace
+
+SavingsAccount::SavingsAccount()
+    : monthlyTransactions(packCount(currentMonthNumber(), 0)), maxMonthlyTransactions(6), annualInterestRate(2.5) {
     setAccountType("Savings");
     setInterestRate(annualInterestRate);
-    setMinimumBalance(minimumBalance);
-    setDailyWithdrawalLimit(2000.0);
-    setMonthlyWithdrawalLimit(10000.0);
+    setMinimumBalance(Money::fromCents(50000));
+    setDailyWithdrawalLimit(Money::fromCents(200000));
+    setMonthlyWithdrawalLimit(Money::fromCents(1000000));
 }
 
 SavingsAccount::SavingsAccount(const std::string& customerId, double initialBalance)
-    : Account(customerId, "Savings", initialBalance), minimumBalance(500.0), 
-      monthlyTransactions(0), maxMonthlyTransactions(6), annualInterestRate(2.5) {
+    : Account(customerId, "Savings", initialBalance), monthlyTransactions(packCount(currentMonthNumber(), 0)),
+      maxMonthlyTransactions(6), annualInterestRate(2.5) {
     setInterestRate(annualInterestRate);
-    setMinimumBalance(minimumBalance);
-    setDailyWithdrawalLimit(2000.0);
-    setMonthlyWithdrawalLimit(10000.0);
+    setMinimumBalance(Money::fromCents(50000));
+    setDailyWithdrawalLimit(Money::fromCents(200000));
+    setMonthlyWithdrawalLimit(Money::fromCents(1000000));
 }
 
 SavingsAccount::~SavingsAccount() {}
 
 // Overridden methods
-bool SavingsAccount::withdraw(double amount) {
-    if (!canWithdraw(amount) || !canMakeTransaction()) {
+bool SavingsAccount::withdraw(Money amount) {
+    // The monthly slot is claimed up front so concurrent withdrawals can't exceed the cap
+    if (!reserveTransactionSlot()) {
         return false;
     }
     
     bool success = Account::withdraw(amount);
-    if (success) {
-        incrementTransactionCount();
+    if (!success) {
+        releaseTransactionSlot();
     }
     return success;
 }
 
-bool SavingsAccount::transfer(Account& targetAccount, double amount) {
-    if (!canTransfer(amount) || !canMakeTransaction()) {
+bool SavingsAccount::transfer(Account& targetAccount, Money amount) {
+    if (!reserveTransactionSlot()) {
         return false;
     }
     
     bool success = Account::transfer(targetAccount, amount);
-    if (success) {
-        incrementTransactionCount();
+    if (!success) {
+        releaseTransactionSlot();
     }
     return success;
 }
 
-double SavingsAccount::calculateInterest() const {
-    return getBalance() * annualInterestRate / 100.0 / 12.0; // Monthly interest
+int SavingsAccount::getInterestPeriodsPerYear() const {
+    return 12; // Annual rate, credited monthly
 }
 
-void SavingsAccount::applyInterest() {
-    double interest = calculateInterest();
-    if (interest > 0) {
-        setBalance(getBalance() + interest);
-        
-        // Create transaction record for interest
-        auto transaction = std::make_shared<Transaction>(
-            getAccountNumber(), "Interest", interest, getBalance(), getCurrentDateTime()
-        );
-        addTransaction(transaction);
-    }
+bool SavingsAccount::canWithdraw(Money amount) const {
+    return Account::canWithdraw(amount) && canMakeTransaction();
 }
 
-bool SavingsAccount::canWithdraw(double amount) const {
-    return Account::canWithdraw(amount) && 
-           getBalance() - amount >= minimumBalance &&
-           canMakeTransaction();
-}
-
-bool SavingsAccount::canTransfer(double amount) const {
+bool SavingsAccount::canTransfer(Money amount) const {
     return canWithdraw(amount);
 }
 
 std::string SavingsAccount::getAccountDetails() const {
     std::ostringstream oss;
     oss << Account::getAccountDetails() << "\n"
-        << "Minimum Balance Required: $" << std::fixed << std::setprecision(2) << minimumBalance << "\n"
-        << "Monthly Transactions: " << monthlyTransactions << "/" << maxMonthlyTransactions << "\n"
+        << "Minimum Balance Required: $" << getMinimumBalanceMoney() << "\n"
+        << "Monthly Transactions: " << getMonthlyTransactions() << "/" << maxMonthlyTransactions << "\n"
         << "Annual Interest Rate: " << annualInterestRate << "%";
     return oss.str();
 }
@@ -93,9 +122,11 @@ void SavingsAccount::displayInfo() const {
 }
 
 std::string SavingsAccount::toFileString() const {
+    long long packed = monthlyTransactions.load(std::memory_order_acquire);
     std::ostringstream oss;
-    oss << Account::toFileString() << "|" << minimumBalance << "|" 
-        << monthlyTransactions << "|" << maxMonthlyTransactions << "|" << annualInterestRate;
+    oss << Account::toFileString() << "|" << getMinimumBalanceMoney() << "|" 
+        << countValue(packed) << "|" << maxMonthlyTransactions << "|" << annualInterestRate << "|"
+        << formatMonth(countMonth(packed));
     return oss.str();
 }
 
@@ -110,25 +141,26 @@ void SavingsAccount::fromFileString(const std::string& data) {
         tokens.push_back(token);
     }
     
-    if (tokens.size() >= 18) {
-        minimumBalance = std::stod(tokens[14]);
-        monthlyTransactions = std::stoi(tokens[15]);
-        maxMonthlyTransactions = std::stoi(tokens[16]);
-        annualInterestRate = std::stod(tokens[17]);
+    // Savings fields follow the 13 written by Account::toFileString
+    if (tokens.size() >= 17) {
+        setMinimumBalance(Money::parse(tokens[13]));
+        // Older files don't say which month the count is for; the day of the
+        // last withdrawal is the closest thing they record
+        long long month = parseMonth(tokens.size() >= 18 ? tokens[17] : tokens[12]);
+        monthlyTransactions.store(packCount(month, std::stoll(tokens[14])), std::memory_order_release);
+        maxMonthlyTransactions = std::stoi(tokens[15]);
+        annualInterestRate = std::stod(tokens[16]);
     }
 }
 
-// Savings-specific methods
-void SavingsAccount::setMinimumBalance(double amount) {
-    minimumBalance = amount;
-}
-
-double SavingsAccount::getMinimumBalance() const {
-    return minimumBalance;
+size_t SavingsAccount::getObjectSize() const {
+    return sizeof(SavingsAccount);
 }
 
+// Savings-specific methods
 int SavingsAccount::getMonthlyTransactions() const {
-    return monthlyTransactions;
+    long long packed = monthlyTransactions.load(std::memory_order_acquire);
+    return countMonth(packed) == currentMonthNumber() ? static_cast<int>(countValue(packed)) : 0;
 }
 
 int SavingsAccount::getMaxMonthlyTransactions() const {
@@ -149,13 +181,47 @@ void SavingsAccount::setAnnualInterestRate(double rate) {
 }
 
 bool SavingsAccount::canMakeTransaction() const {
-    return monthlyTransactions < maxMonthlyTransactions;
+    return getMonthlyTransactions() < maxMonthlyTransactions;
 }
 
 void SavingsAccount::incrementTransactionCount() {
-    monthlyTransactions++;
+    long long month = currentMonthNumber();
+    long long current = monthlyTransactions.load(std::memory_order_relaxed);
+    long long used;
+    do {
+        used = countMonth(current) == month ? countValue(current) : 0;
+    } while (!monthlyTransactions.compare_exchange_weak(current, packCount(month, used + 1),
+                                                        std::memory_order_acq_rel, std::memory_order_relaxed));
 }
 
 void SavingsAccount::resetMonthlyTransactions() {
-    monthlyTransactions = 0;
+    monthlyTransactions.store(packCount(currentMonthNumber(), 0), std::memory_order_release);
+}
+
+bool SavingsAccount::reserveTransactionSlot() {
+    long long month = currentMonthNumber();
+    long long current = monthlyTransactions.load(std::memory_order_relaxed);
+    while (true) {
+        long long used = countMonth(current) == month ? countValue(current) : 0;
+        if (used >= maxMonthlyTransactions) {
+            BankMetrics::shared().declinedMonthlyCap.add();
+            return false;
+        }
+        if (monthlyTransactions.compare_exchange_weak(current, packCount(month, used + 1),
+                                                      std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void SavingsAccount::releaseTransactionSlot() {
+    // A slot claimed just before the month turned over is already gone with its month
+    long long month = currentMonthNumber();
+    long long current = monthlyTransactions.load(std::memory_order_relaxed);
+    while (countMonth(current) == month && countValue(current) > 0) {
+        if (monthlyTransactions.compare_exchange_weak(current, packCount(month, countValue(current) - 1),
+                                                      std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
+        }
+    }
 }
@@ -6,8 +6,7 @@
 
 class SavingsAccount : public Account {
 private:
-    double minimumBalance;
-    int monthlyTransactions;
+    std::atomic<long long> monthlyTransactions; // Month number in the high bits, transactions that month below
     int maxMonthlyTransactions;
     double annualInterestRate;
 
@@ -18,21 +17,21 @@ public:
     ~SavingsAccount();
 
     // Overridden methods
-    bool withdraw(double amount) override;
-    bool transfer(Account& targetAccount, double amount) override;
-    double calculateInterest() const override;
-    void applyInterest() override;
-    bool canWithdraw(double amount) const override;
-    bool canTransfer(double amount) const override;
+    using Account::withdraw;
+    using Account::transfer;
+    bool withdraw(Money amount) override;
+    bool transfer(Account& targetAccount, Money amount) override;
+    int getInterestPeriodsPerYear() const override;
+    bool canWithdraw(Money amount) const override;
+    bool canTransfer(Money amount) const override;
     
     std::string getAccountDetails() const override;
     void displayInfo() const override;
     std::string toFileString() const override;
     void fromFileString(const std::string& data) override;
+    size_t getObjectSize() const override;
 
     // Savings-specific methods
-    void setMinimumBalance(double amount);
-    double getMinimumBalance() const;
     int getMonthlyTransactions() const;
     int getMaxMonthlyTransactions() const;
     void setMaxMonthlyTransactions(int max);
@@ -41,6 +40,10 @@ public:
     bool canMakeTransaction() const;
     void incrementTransactionCount();
     void resetMonthlyTransactions();
+
+private:
+    bool reserveTransactionSlot();
+    void releaseTransactionSlot();
 };
 
 #endif // SAVINGS_ACCOUNT_H
@@ -0,0 +1,198 @@
+#include "StatementGenerator.h"
+#include "Account.h"
+#include "Transaction.h"
+#include "PeriodClock.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+
+namespace {
+
+const char* const kRule = "══════════════════════════════════════════════════════════════\n";
+
+void appendPadded(std::string& text, const std::string& value, size_t width, bool alignRight) {
+    size_t padding = value.size() < width ? width - value.size() : 0;
+    if (alignRight) {
+        text.append(padding, ' ');
+    }
+    text += value;
+    if (!alignRight) {
+        text.append(padding, ' ');
+    }
+}
+
+void appendAmountLine(std::string& text, const char* label, const char* sign, Money amount) {
+    appendPadded(text, label, 26, false);
+    appendPadded(text, sign + std::string("$") + amount.toString(), 18, true);
+    text += '\n';
+}
+
+} // namespace
+
+StatementGenerator::StatementGenerator(int year, int month, const std::string& baseDirectory,
+                                       const std::string& generatedAt)
+    : year(year), month(month), generatedAt(generatedAt) {
+    int nextYear = month == 12 ? year + 1 : year;
+    unsigned nextMonth = month == 12 ? 1 : static_cast<unsigned>(month + 1);
+    long long days = PeriodClock::daysFromCivil(nextYear, nextMonth, 1) -
+                     PeriodClock::daysFromCivil(year, static_cast<unsigned>(month), 1);
+
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d", year, month);
+    period = buffer;
+    firstDay = period + "-01";
+    std::snprintf(buffer, sizeof(buffer), "%s-%02lld", period.c_str(), days);
+    lastDay = buffer;
+    directory = baseDirectory + "/" + period;
+}
+
+// Getters
+std::string StatementGenerator::getPeriod() const {
+    return period;
+}
+
+std::string StatementGenerator::getDirectory() const {
+    return directory;
+}
+
+std::string StatementGenerator::getStatementPath(const std::string& accountNumber) const {
+    return directory + "/" + accountNumber + ".txt";
+}
+
+// Statement generation
+bool StatementGenerator::prepareDirectory() const {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    return !error;
+}
+
+StatementSummary StatementGenerator::summarize(const Account& account, Money currentBalance,
+                                               std::vector<Transaction>& entries) const {
+    StatementSummary summary{};
+    entries.clear();
+
+    // Dates start with "YYYY-MM", so comparing that prefix places a transaction relative to the month
+    bool anyLater = false;
+    bool anyBefore = false;
+    Money openingAfter;  // Balance before the earliest transaction after the month
+    Money closingBefore; // Balance after the latest transaction before it
+    account.forEachTransaction([&](const Transaction& transaction) {
+        int order = transaction.getDate().compare(0, period.size(), period);
+        if (order > 0) {
+            anyLater = true;
+            openingAfter = transaction.getBalanceMoney() - transaction.getAmountMoney();
+            return true;
+        }
+        if (order == 0) {
+            entries.push_back(transaction);
+            return true;
+        }
+        anyBefore = true;
+        closingBefore = transaction.getBalanceMoney();
+        return false;
+    });
+    std::reverse(entries.begin(), entries.end());
+
+    // Balances come from the transactions themselves, so a statement for a
+    // past month is not disturbed by postings made since
+    if (!entries.empty()) {
+        const Transaction& first = entries.front();
+        summary.openingBalance = first.getBalanceMoney() - first.getAmountMoney();
+        summary.closingBalance = entries.back().getBalanceMoney();
+    } else if (anyBefore) {
+        summary.openingBalance = closingBefore;
+        summary.closingBalance = summary.openingBalance;
+    } else if (anyLater) {
+        summary.openingBalance = openingAfter;
+        summary.closingBalance = summary.openingBalance;
+    } else {
+        summary.openingBalance = currentBalance;
+        summary.closingBalance = currentBalance;
+    }
+
+    for (const Transaction& transaction : entries) {
+        Money amount = transaction.getAmountMoney();
+        if (transaction.getType() == "Interest") {
+            summary.interest += amount;
+        } else if (amount < Money()) {
+            summary.debits += amount.abs();
+        } else {
+            summary.credits += amount;
+        }
+    }
+    summary.transactionCount = entries.size();
+    return summary;
+}
+
+bool StatementGenerator::writeStatement(const Account& account, Money currentBalance,
+                                        StatementScratch& scratch) const {
+    StatementSummary summary = summarize(account, currentBalance, scratch.entries);
+    render(account, summary, scratch.entries, scratch.text);
+
+    std::ofstream file(getStatementPath(account.getAccountNumber()), std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(scratch.text.data(), static_cast<std::streamsize>(scratch.text.size()));
+    return static_cast<bool>(file);
+}
+
+// Period helpers
+bool StatementGenerator::parsePeriod(const std::string& text, int& year, int& month) {
+    int parsedYear = 0, parsedMonth = 0;
+    char extra = 0;
+    if (std::sscanf(text.c_str(), "%4d-%2d%c", &parsedYear, &parsedMonth, &extra) != 2) {
+        return false;
+    }
+    if (parsedYear < 1970 || parsedMonth < 1 || parsedMonth > 12) {
+        return false;
+    }
+    year = parsedYear;
+    month = parsedMonth;
+    return true;
+}
+
+void StatementGenerator::previousMonth(int& year, int& month) {
+    long long monthNumber = PeriodClock::shared().getMonthNumber() - 1;
+    year = static_cast<int>(monthNumber / 12);
+    month = static_cast<int>(monthNumber % 12) + 1;
+}
+
+// Helper methods
+void StatementGenerator::render(const Account& account, const StatementSummary& summary,
+                                const std::vector<Transaction>& entries, std::string& text) const {
+    text.clear();
+    text += kRule;
+    text += "                  MONTHLY ACCOUNT STATEMENT\n";
+    text += kRule;
+    text += "Statement Period: " + firstDay + " to " + lastDay + "\n";
+    text += "Account: " + account.getAccountNumber() + " (" + account.getAccountType() + ")\n";
+    text += "Customer ID: " + account.getCustomerId() + "\n";
+    text += "Generated: " + generatedAt + "\n\n";
+
+    appendAmountLine(text, "Opening Balance:", "", summary.openingBalance);
+    appendAmountLine(text, "  Deposits and credits:", "+", summary.credits);
+    appendAmountLine(text, "  Withdrawals and debits:", "-", summary.debits);
+    appendAmountLine(text, "  Interest earned:", "+", summary.interest);
+    appendAmountLine(text, "Closing Balance:", "", summary.closingBalance);
+    text += "\n";
+
+    if (entries.empty()) {
+        text += "No transactions this period.\n";
+    } else {
+        appendPadded(text, "Date", 20, false);
+        appendPadded(text, "Type", 15, false);
+        appendPadded(text, "Amount", 15, true);
+        appendPadded(text, "Balance", 15, true);
+        text += "\n" + std::string(65, '-') + "\n";
+        for (const Transaction& transaction : entries) {
+            appendPadded(text, transaction.getDate(), 20, false);
+            appendPadded(text, transaction.getType(), 15, false);
+            appendPadded(text, transaction.getFormattedAmount(), 15, true);
+            appendPadded(text, "$" + transaction.getBalanceMoney().toString(), 15, true);
+            text += '\n';
+        }
+    }
+    text += kRule;
+}
@@ -0,0 +1,70 @@
+#ifndef STATEMENT_GENERATOR_H
+#define STATEMENT_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "Money.h"
+#include "Transaction.h"
+
+class Account;
+
+// Totals for one account over one statement month
+struct StatementSummary {
+    Money openingBalance;
+    Money closingBalance;
+    Money credits;  // Deposits and incoming transfers, not counting interest
+    Money debits;   // Withdrawals and outgoing transfers, as a positive amount
+    Money interest;
+    size_t transactionCount;
+};
+
+// Per-worker buffers, reused from one account to the next
+struct StatementScratch {
+    std::vector<Transaction> entries; // Copies: archived history is only lent for the length of a visit
+    std::string text;
+};
+
+// Renders monthly account statements, one file per account.
+//
+// An account's history is walked newest first and the walk stops at the
+// first transaction before the month, so the cost follows the month's
+// activity rather than the account's age. Each statement is rendered into
+// the caller's scratch buffer and written straight to its own file; the
+// generator holds no shared state, so any number of workers can use one
+// instance at the same time.
+class StatementGenerator {
+private:
+    int year;
+    int month;
+    std::string period;     // "YYYY-MM"
+    std::string firstDay;   // "YYYY-MM-01"
+    std::string lastDay;    // "YYYY-MM-DD"
+    std::string directory;  // <base>/<period>
+    std::string generatedAt;
+
+public:
+    // Constructor
+    StatementGenerator(int year, int month, const std::string& baseDirectory, const std::string& generatedAt);
+
+    // Getters
+    std::string getPeriod() const;
+    std::string getDirectory() const;
+    std::string getStatementPath(const std::string& accountNumber) const;
+
+    // Statement generation
+    bool prepareDirectory() const;
+    StatementSummary summarize(const Account& account, Money currentBalance,
+                               std::vector<Transaction>& entries) const;
+    bool writeStatement(const Account& account, Money currentBalance, StatementScratch& scratch) const;
+
+    // Period helpers
+    static bool parsePeriod(const std::string& text, int& year, int& month); // "YYYY-MM"
+    static void previousMonth(int& year, int& month); // The month before the current local date
+
+private:
+    void render(const Account& account, const StatementSummary& summary,
+                const std::vector<Transaction>& entries, std::string& text) const;
+};
+
+#endif // STATEMENT_GENERATOR_H
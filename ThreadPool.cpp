@@ -0,0 +1,182 @@
+#include "ThreadPool.h"
+#include <chrono>
+
+namespace {
+
+const size_t kNotAWorker = static_cast<size_t>(-1);
+
+// Which pool (and which of its queues) the current thread works for
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentIndex = kNotAWorker;
+
+} // namespace
+
+// Completion tracking for one parallelFor call
+struct ThreadPool::RangeJob {
+    const std::function<void(size_t, size_t)>* body;
+    BatchProgress* progress;
+    size_t grain;
+    std::atomic<size_t> remaining;
+};
+
+double BatchProgress::getFraction() const {
+    size_t total = totalItems.load();
+    return total == 0 ? 1.0 : static_cast<double>(completedItems.load()) / static_cast<double>(total);
+}
+
+ThreadPool::ThreadPool(size_t threadCount) : pendingTasks(0), nextQueue(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    // One extra queue for tasks submitted from outside the pool
+    for (size_t i = 0; i <= threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Task submission
+void ThreadPool::submit(Task task) {
+    pushTo(ownQueue(), std::move(task));
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return workers.size();
+}
+
+void ThreadPool::parallelFor(size_t first, size_t last, size_t grain,
+                             const std::function<void(size_t, size_t)>& body,
+                             BatchProgress* progress) {
+    if (grain == 0) grain = 1;
+    if (progress) {
+        progress->totalItems = last > first ? last - first : 0;
+        progress->completedItems = 0;
+        progress->running = true;
+    }
+    if (last <= first) {
+        if (progress) progress->running = false;
+        return;
+    }
+
+    auto job = std::make_shared<RangeJob>();
+    job->body = &body;
+    job->progress = progress;
+    job->grain = grain;
+    job->remaining = last - first;
+
+    runRange(job, first, last);
+
+    // Help until every sub-range has run
+    size_t self = ownQueue();
+    while (job->remaining.load() > 0) {
+        if (!runOneTask(self)) {
+            std::this_thread::yield();
+        }
+    }
+    if (progress) {
+        progress->running = false;
+    }
+}
+
+// Helper methods
+void ThreadPool::runRange(const std::shared_ptr<RangeJob>& job, size_t begin, size_t end) {
+    // Keep the left half and push the right half, where thieves will find it
+    while (end - begin > job->grain) {
+        size_t middle = begin + (end - begin) / 2;
+        submit([this, job, middle, end]() { runRange(job, middle, end); });
+        end = middle;
+    }
+    (*job->body)(begin, end);
+    if (job->progress) {
+        job->progress->completedItems.fetch_add(end - begin);
+    }
+    job->remaining.fetch_sub(end - begin);
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        if (runOneTask(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wakeUp.wait_for(guard, std::chrono::milliseconds(50), [this]() {
+            return stopping.load() || pendingTasks.load() > 0;
+        });
+        if (stopping && pendingTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::runOneTask(size_t preferredQueue) {
+    Task task;
+    if (popLocal(preferredQueue, task) || steal(preferredQueue, task)) {
+        pendingTasks.fetch_sub(1);
+        task();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::popLocal(size_t index, Task& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task& task) {
+    size_t count = queues.size();
+    size_t start = nextQueue.fetch_add(1) % count;
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim == thief) continue;
+
+        WorkerQueue& queue = *queues[victim];
+        std::unique_lock<std::mutex> guard(queue.lock, std::try_to_lock);
+        if (!guard.owns_lock() || queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::pushTo(size_t index, Task task) {
+    pendingTasks.fetch_add(1); // Counted before it becomes visible, so the count never underflows
+    {
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+    wakeUp.notify_one();
+}
+
+size_t ThreadPool::ownQueue() const {
+    // Threads outside this pool share the extra queue at the end
+    return currentPool == this ? currentIndex : workers.size();
+}
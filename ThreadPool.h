@@ -0,0 +1,78 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <string>
+
+// Progress of the batch job currently running on a pool. Safe to read
+// from any thread while the job runs.
+struct BatchProgress {
+    std::atomic<size_t> totalItems{0};
+    std::atomic<size_t> completedItems{0};
+    std::atomic<bool> running{false};
+
+    double getFraction() const;
+};
+
+// Work-stealing task scheduler.
+//
+// Each worker owns a deque: it pushes and pops its own tasks at the back,
+// and idle workers steal from the front of other workers' deques. Ranges
+// passed to parallelFor are split recursively, so large halves are what
+// gets stolen and load balances itself across cores.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct RangeJob;
+
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pendingTasks;
+    std::atomic<size_t> nextQueue;
+    std::atomic<bool> stopping;
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+
+public:
+    // Constructor and destructor
+    explicit ThreadPool(size_t threadCount = 0); // 0 = one worker per core
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Task submission
+    void submit(Task task);
+    size_t getThreadCount() const;
+
+    // Runs body(begin, end) over sub-ranges of [first, last) no larger than
+    // grain, blocking until all are done. The calling thread helps out.
+    void parallelFor(size_t first, size_t last, size_t grain,
+                     const std::function<void(size_t, size_t)>& body,
+                     BatchProgress* progress = nullptr);
+
+private:
+    // Helper methods
+    void runRange(const std::shared_ptr<RangeJob>& job, size_t begin, size_t end);
+    void workerLoop(size_t index);
+    bool runOneTask(size_t preferredQueue);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+    void pushTo(size_t index, Task task);
+    size_t ownQueue() const;
+};
+
+#endif // THREAD_POOL_H
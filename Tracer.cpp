@@ -0,0 +1,133 @@
+#include "Tracer.h"
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+// This thread's buffer in the shared tracer; buffers live as long as the tracer
+thread_local void* localTraceBuffer = nullptr;
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+// Tracer::ThreadBuffer
+Tracer::ThreadBuffer::ThreadBuffer(int threadId) : threadId(threadId), head(new Chunk()), tail(head) {}
+
+Tracer::ThreadBuffer::~ThreadBuffer() {
+    Chunk* chunk = head;
+    while (chunk) {
+        Chunk* next = chunk->next.load();
+        delete chunk;
+        chunk = next;
+    }
+}
+
+// Constructor
+Tracer::Tracer() : enabled(false), origin(std::chrono::steady_clock::now()) {}
+
+Tracer& Tracer::shared() {
+    static Tracer tracer;
+    return tracer;
+}
+
+// Control
+void Tracer::start() {
+    enabled.store(true);
+}
+
+void Tracer::stop() {
+    enabled.store(false);
+}
+
+// Recording
+void Tracer::record(const char* name, const char* category, std::chrono::steady_clock::time_point begin,
+                    std::chrono::steady_clock::time_point end) {
+    ThreadBuffer& buffer = localBuffer();
+    Chunk* chunk = buffer.tail;
+    size_t count = chunk->count.load(std::memory_order_relaxed);
+    if (count == kChunkSize) {
+        Chunk* fresh = new Chunk();
+        chunk->next.store(fresh, std::memory_order_release);
+        buffer.tail = fresh;
+        chunk = fresh;
+        count = 0;
+    }
+    chunk->events[count] = TraceEvent{
+        name, category,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(begin - origin).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()};
+    chunk->count.store(count + 1, std::memory_order_release);
+}
+
+// Export
+size_t Tracer::getEventCount() const {
+    std::lock_guard<std::mutex> guard(buffersLock);
+    size_t total = 0;
+    for (const auto& buffer : buffers) {
+        for (const Chunk* chunk = buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            total += chunk->count.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+void Tracer::writeChromeTrace(std::ostream& out) const {
+    std::lock_guard<std::mutex> guard(buffersLock);
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"oyanib_bank\"}}";
+    out << std::fixed << std::setprecision(3);
+    for (const auto& buffer : buffers) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":\"Thread " << buffer->threadId << "\"}}";
+        for (const Chunk* chunk = buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t count = chunk->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const TraceEvent& event = chunk->events[i];
+                out << ",\n{\"name\":";
+                writeJsonString(out, event.name);
+                out << ",\"cat\":";
+                writeJsonString(out, event.category);
+                out << ",\"ph\":\"X\",\"ts\":" << event.beginNanos / 1000.0 << ",\"dur\":"
+                    << event.durationNanos / 1000.0 << ",\"pid\":1,\"tid\":" << buffer->threadId << "}";
+            }
+        }
+    }
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool Tracer::writeChromeTrace(const std::string& fileName) const {
+    std::ofstream file(fileName);
+    if (!file.is_open()) {
+        return false;
+    }
+    writeChromeTrace(file);
+    return static_cast<bool>(file);
+}
+
+// Helper methods
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    if (localTraceBuffer) {
+        return *static_cast<ThreadBuffer*>(localTraceBuffer);
+    }
+    // First span from this thread
+    std::lock_guard<std::mutex> guard(buffersLock);
+    buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<int>(buffers.size()) + 1));
+    localTraceBuffer = buffers.back().get();
+    return *buffers.back();
+}
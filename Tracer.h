@@ -0,0 +1,107 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// One finished span. Names and categories must outlive the tracer (string literals)
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    int64_t beginNanos; // Since the tracer was created
+    int64_t durationNanos;
+};
+
+// Optional span tracing for performance investigations, exported as
+// Chrome trace-event JSON (chrome://tracing, Perfetto).
+//
+// Each thread appends finished spans to its own buffer, a chain of
+// fixed-size chunks that only the owning thread writes; publishing an event
+// is a release store of the chunk's count, so recording never takes a lock
+// and the exporter can read every buffer while threads keep tracing. While
+// tracing is off a span costs one relaxed load.
+class Tracer {
+public:
+    static const size_t kChunkSize = 4096;
+
+private:
+    struct Chunk {
+        TraceEvent events[kChunkSize];
+        std::atomic<size_t> count{0};
+        std::atomic<Chunk*> next{nullptr};
+    };
+
+    struct ThreadBuffer {
+        int threadId;
+        Chunk* head;
+        Chunk* tail; // Owning thread only
+        explicit ThreadBuffer(int threadId);
+        ~ThreadBuffer();
+    };
+
+    std::atomic<bool> enabled;
+    const std::chrono::steady_clock::time_point origin;
+    mutable std::mutex buffersLock;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+public:
+    // Constructor
+    Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    // Process-wide tracer used by all spans
+    static Tracer& shared();
+
+    // Control
+    void start();
+    void stop();
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Recording
+    void record(const char* name, const char* category, std::chrono::steady_clock::time_point begin,
+                std::chrono::steady_clock::time_point end);
+
+    // Export
+    size_t getEventCount() const;
+    void writeChromeTrace(std::ostream& out) const;
+    bool writeChromeTrace(const std::string& fileName) const;
+
+private:
+    ThreadBuffer& localBuffer();
+};
+
+// Records the lifetime of a scope as one span when tracing is on
+class TraceSpan {
+private:
+    const char* name;
+    const char* category;
+    bool active;
+    std::chrono::steady_clock::time_point begin;
+
+public:
+    TraceSpan(const char* name, const char* category)
+        : name(name), category(category), active(Tracer::shared().isEnabled()) {
+        if (active) {
+            begin = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (active) {
+            Tracer::shared().record(name, category, begin, std::chrono::steady_clock::now());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+#endif // TRACER_H
@@ -1,24 +1,25 @@
 #include "Transaction.h"
+#include "MemoryAccounting.h"
+#include "IdGenerator.h"
+#include "PeriodClock.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
-#include <ctime>
-#include <random>
 
-Transaction::Transaction() : amount(0.0), balance(0.0), status("Pending") {
+Transaction::Transaction() : amount(), balance(), status("Pending") {
     generateTransactionId();
     date = getCurrentDateTime();
 }
 
 Transaction::Transaction(const std::string& accountNumber, const std::string& type, 
-                         double amount, double balance, const std::string& date)
+                         Money amount, Money balance, const std::string& date)
     : accountNumber(accountNumber), type(type), amount(amount), balance(balance), 
       date(date), status("Completed") {
     generateTransactionId();
 }
 
 Transaction::Transaction(const std::string& accountNumber, const std::string& type, 
-                         double amount, double balance, const std::string& date, 
+                         Money amount, Money balance, const std::string& date, 
                          const std::string& description)
     : accountNumber(accountNumber), type(type), amount(amount), balance(balance), 
       date(date), description(description), status("Completed") {
@@ -31,8 +32,10 @@ Transaction::~Transaction() {}
 std::string Transaction::getTransactionId() const { return transactionId; }
 std::string Transaction::getAccountNumber() const { return accountNumber; }
 std::string Transaction::getType() const { return type; }
-double Transaction::getAmount() const { return amount; }
-double Transaction::getBalance() const { return balance; }
+double Transaction::getAmount() const { return amount.toDouble(); }
+double Transaction::getBalance() const { return balance.toDouble(); }
+Money Transaction::getAmountMoney() const { return amount; }
+Money Transaction::getBalanceMoney() const { return balance; }
 std::string Transaction::getDate() const { return date; }
 std::string Transaction::getDescription() const { return description; }
 std::string Transaction::getStatus() const { return status; }
@@ -41,26 +44,19 @@ std::string Transaction::getStatus() const { return status; }
 void Transaction::setTransactionId(const std::string& id) { transactionId = id; }
 void Transaction::setAccountNumber(const std::string& accountNum) { accountNumber = accountNum; }
 void Transaction::setType(const std::string& type) { this->type = type; }
-void Transaction::setAmount(double amount) { this->amount = amount; }
-void Transaction::setBalance(double balance) { this->balance = balance; }
+void Transaction::setAmount(Money amount) { this->amount = amount; }
+void Transaction::setBalance(Money balance) { this->balance = balance; }
 void Transaction::setDate(const std::string& date) { this->date = date; }
 void Transaction::setDescription(const std::string& description) { this->description = description; }
 void Transaction::setStatus(const std::string& status) { this->status = status; }
 
 // Utility methods
 void Transaction::generateTransactionId() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(100000000, 999999999);
-    transactionId = "TXN" + std::to_string(dis(gen));
+    transactionId = "TXN" + std::to_string(IdGenerator::shared().next(100000000, 999999999));
 }
 
 std::string Transaction::getCurrentDateTime() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    return PeriodClock::shared().timestamp();
 }
 
 void Transaction::displayInfo() const {
@@ -71,7 +67,7 @@ void Transaction::displayInfo() const {
     std::cout << "Account Number: " << accountNumber << "\n";
     std::cout << "Type: " << type << "\n";
     std::cout << "Amount: " << getFormattedAmount() << "\n";
-    std::cout << "Balance After: $" << std::fixed << std::setprecision(2) << balance << "\n";
+    std::cout << "Balance After: $" << balance << "\n";
     std::cout << "Date: " << date << "\n";
     std::cout << "Status: " << status << "\n";
     if (!description.empty()) {
@@ -100,8 +96,8 @@ void Transaction::fromFileString(const std::string& data) {
         transactionId = tokens[0];
         accountNumber = tokens[1];
         type = tokens[2];
-        amount = std::stod(tokens[3]);
-        balance = std::stod(tokens[4]);
+        amount = Money::parse(tokens[3]);
+        balance = Money::parse(tokens[4]);
         date = tokens[5];
         description = tokens[6];
         status = tokens[7];
@@ -109,19 +105,26 @@ void Transaction::fromFileString(const std::string& data) {
 }
 
 bool Transaction::isCredit() const {
-    return amount > 0;
+    return amount > Money();
 }
 
 bool Transaction::isDebit() const {
-    return amount < 0;
+    return amount < Money();
 }
 
 std::string Transaction::getFormattedAmount() const {
     std::ostringstream oss;
     if (isCredit()) {
-        oss << "+$" << std::fixed << std::setprecision(2) << amount;
+        oss << "+$" << amount;
     } else {
-        oss << "-$" << std::fixed << std::setprecision(2) << std::abs(amount);
+        oss << "-$" << amount.abs();
     }
     return oss.str();
 }
+
+void Transaction::addMemoryUsage(MemoryReport& report) const {
+    report.addShared(MemorySubsystem::Transactions, sizeof(Transaction));
+    for (const std::string* field : {&transactionId, &accountNumber, &type, &date, &description, &status}) {
+        report.addString(*field);
+    }
+}
@@ -4,13 +4,17 @@
 #include <string>
 #include <chrono>
 
+#include "Money.h"
+
+class MemoryReport;
+
 class Transaction {
 private:
     std::string transactionId;
     std::string accountNumber;
     std::string type; // "Deposit", "Withdrawal", "Transfer", "Interest", "Loan"
-    double amount;
-    double balance;
+    Money amount;
+    Money balance;
     std::string date;
     std::string description;
     std::string status; // "Pending", "Completed", "Failed", "Cancelled"
@@ -19,9 +23,9 @@ public:
     // Constructors
     Transaction();
     Transaction(const std::string& accountNumber, const std::string& type, 
-                double amount, double balance, const std::string& date);
+                Money amount, Money balance, const std::string& date);
     Transaction(const std::string& accountNumber, const std::string& type, 
-                double amount, double balance, const std::string& date, 
+                Money amount, Money balance, const std::string& date, 
                 const std::string& description);
     ~Transaction();
 
@@ -31,6 +35,8 @@ public:
     std::string getType() const;
     double getAmount() const;
     double getBalance() const;
+    Money getAmountMoney() const;
+    Money getBalanceMoney() const;
     std::string getDate() const;
     std::string getDescription() const;
     std::string getStatus() const;
@@ -39,8 +45,8 @@ public:
     void setTransactionId(const std::string& id);
     void setAccountNumber(const std::string& accountNum);
     void setType(const std::string& type);
-    void setAmount(double amount);
-    void setBalance(double balance);
+    void setAmount(Money amount);
+    void setBalance(Money balance);
     void setDate(const std::string& date);
     void setDescription(const std::string& description);
     void setStatus(const std::string& status);
@@ -54,6 +60,7 @@ public:
     bool isCredit() const;
     bool isDebit() const;
     std::string getFormattedAmount() const;
+    void addMemoryUsage(MemoryReport& report) const;
 };
 
 #endif // TRANSACTION_H
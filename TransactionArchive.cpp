@@ -0,0 +1,217 @@
+#include "TransactionArchive.h"
+#include "Transaction.h"
+#include "PersistenceProfile.h"
+#include "MemoryAccounting.h"
+#include "Money.h"
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <cstring>
+
+namespace {
+
+const size_t kBlockSize = size_t(1) << 20;
+const int kFieldCount = 8; // id|account|type|amount|balance|date|description|status
+
+} // namespace
+
+// Constructor
+TransactionArchive::TransactionArchive()
+    : byteCount(0), endsWithNewline(true), transactionCount(0), creditCents(0), debitCents(0) {}
+
+// Loading
+bool TransactionArchive::load(const std::string& fileName, FileProfile& profile) {
+    clear();
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::error_code code;
+    path = std::filesystem::absolute(fileName, code).string();
+    if (code) {
+        path = fileName;
+    }
+
+    // Lines are only split into the fields the index needs, straight out of
+    // the read buffer; the account and amount strings are reused, so a line
+    // allocates nothing unless it names a new account. Histories tend to come
+    // in runs, so the previous account's offsets are tried before the map
+    std::string account;
+    std::string amount;
+    std::string lastAccount;
+    std::vector<uint64_t>* lastOffsets = nullptr;
+    auto indexLine = [&](const char* line, size_t length, uint64_t offset) {
+        transactionCount++;
+        const char* pipes[kFieldCount - 1];
+        const char* cursor = line;
+        const char* end = line + length;
+        int found = 0;
+        while (found < kFieldCount - 1) {
+            const char* pipe = static_cast<const char*>(std::memchr(cursor, '|', end - cursor));
+            if (!pipe) {
+                return; // Short lines load as blank transactions, belonging to no account
+            }
+            pipes[found++] = pipe;
+            cursor = pipe + 1;
+        }
+        account.assign(pipes[0] + 1, pipes[1]);
+        amount.assign(pipes[2] + 1, pipes[3]);
+        long long cents = Money::parse(amount).getCents();
+        if (cents > 0) {
+            creditCents += cents;
+        } else {
+            debitCents -= cents;
+        }
+        if (!lastOffsets || account != lastAccount) {
+            lastOffsets = &offsetsByAccount[account];
+            lastAccount = account;
+        }
+        lastOffsets->push_back(offset);
+    };
+
+    PhaseTimer timer(profile);
+    std::vector<char> buffer(kBlockSize);
+    size_t carried = 0;       // Unfinished line kept at the front of the buffer
+    uint64_t bufferStart = 0; // File offset of buffer[0]
+    while (true) {
+        if (carried == buffer.size()) {
+            buffer.resize(buffer.size() * 2); // A single line longer than the buffer
+        }
+        file.read(buffer.data() + carried, buffer.size() - carried);
+        size_t got = static_cast<size_t>(file.gcount());
+        timer.lap(PersistencePhase::Read);
+        if (got == 0) {
+            break;
+        }
+        profile.bytes += got;
+        size_t filled = carried + got;
+
+        size_t lineStart = 0;
+        while (lineStart < filled) {
+            const char* newline = static_cast<const char*>(std::memchr(buffer.data() + lineStart, '\n', filled - lineStart));
+            if (!newline) {
+                break;
+            }
+            size_t lineEnd = newline - buffer.data();
+            indexLine(buffer.data() + lineStart, lineEnd - lineStart, bufferStart + lineStart);
+            lineStart = lineEnd + 1;
+        }
+        carried = filled - lineStart;
+        std::memmove(buffer.data(), buffer.data() + lineStart, carried);
+        bufferStart += lineStart;
+        timer.lap(PersistencePhase::Index);
+    }
+    if (carried > 0) {
+        // Last line without a trailing newline
+        indexLine(buffer.data(), carried, bufferStart);
+        endsWithNewline = false;
+    }
+    byteCount = bufferStart + carried;
+    profile.records += transactionCount;
+    timer.lap(PersistencePhase::Index);
+    return true;
+}
+
+void TransactionArchive::clear() {
+    path.clear();
+    byteCount = 0;
+    endsWithNewline = true;
+    transactionCount = 0;
+    creditCents = 0;
+    debitCents = 0;
+    offsetsByAccount.clear();
+}
+
+// Queries
+size_t TransactionArchive::size() const { return transactionCount; }
+bool TransactionArchive::empty() const { return transactionCount == 0; }
+uint64_t TransactionArchive::getByteCount() const { return byteCount; }
+bool TransactionArchive::needsLineBreak() const { return !endsWithNewline; }
+long long TransactionArchive::getCreditCents() const { return creditCents; }
+long long TransactionArchive::getDebitCents() const { return debitCents; }
+
+size_t TransactionArchive::countFor(const std::string& accountNumber) const {
+    auto it = offsetsByAccount.find(accountNumber);
+    return it == offsetsByAccount.end() ? 0 : it->second.size();
+}
+
+// Reading back
+std::vector<std::shared_ptr<Transaction>> TransactionArchive::readAccount(const std::string& accountNumber) const {
+    std::vector<std::shared_ptr<Transaction>> history;
+    auto it = offsetsByAccount.find(accountNumber);
+    if (it == offsetsByAccount.end()) {
+        return history;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Warning: cannot read transaction history for " << accountNumber << " from " << path << "\n";
+        return history;
+    }
+
+    history.reserve(it->second.size());
+    std::string line;
+    for (uint64_t offset : it->second) {
+        file.seekg(static_cast<std::streamoff>(offset));
+        if (!std::getline(file, line)) {
+            break;
+        }
+        auto transaction = std::make_shared<Transaction>();
+        transaction->fromFileString(line);
+        history.push_back(transaction);
+    }
+    return history;
+}
+
+void TransactionArchive::visitAccount(const std::string& accountNumber,
+                                      const std::function<bool(const Transaction&)>& visit) const {
+    auto it = offsetsByAccount.find(accountNumber);
+    if (it == offsetsByAccount.end()) {
+        return;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Warning: cannot read transaction history for " << accountNumber << " from " << path << "\n";
+        return;
+    }
+
+    std::string line;
+    for (auto offset = it->second.rbegin(); offset != it->second.rend(); ++offset) {
+        file.seekg(static_cast<std::streamoff>(*offset));
+        if (!std::getline(file, line)) {
+            break;
+        }
+        Transaction transaction;
+        transaction.fromFileString(line);
+        if (!visit(transaction)) {
+            return;
+        }
+    }
+}
+
+void TransactionArchive::forEach(const std::function<void(const Transaction&)>& visit) const {
+    if (transactionCount == 0) {
+        return;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Warning: cannot read archived transactions from " << path << "\n";
+        return;
+    }
+    std::string line;
+    uint64_t consumed = 0;
+    while (consumed < byteCount && std::getline(file, line)) {
+        consumed += line.size() + 1;
+        Transaction transaction;
+        transaction.fromFileString(line);
+        visit(transaction);
+    }
+}
+
+// Memory accounting
+void TransactionArchive::addMemoryUsage(MemoryReport& report) const {
+    report.addHashMap(MemorySubsystem::Indexes, offsetsByAccount);
+    for (const auto& entry : offsetsByAccount) {
+        report.addVector(MemorySubsystem::Indexes, entry.second);
+    }
+    report.addString(path);
+}
@@ -0,0 +1,64 @@
+#ifndef TRANSACTION_ARCHIVE_H
+#define TRANSACTION_ARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+class Transaction;
+class MemoryReport;
+struct FileProfile;
+
+// Transactions persisted by earlier runs, left on disk until someone reads them.
+//
+// Loading scans transactions.txt once and keeps only where each account's
+// lines start, plus the count and credit/debit totals the statistics need;
+// no Transaction is built. An account materializes its own history from
+// the offsets the first time it is read interactively; whole-bank passes
+// stream it instead, so they leave nothing resident. The indexed prefix of the file is
+// never rewritten while the bank runs (saves cut the file back to it and
+// append the journal), so the offsets stay valid until the next load.
+class TransactionArchive {
+private:
+    std::string path; // Absolute, so reads still work after a chdir
+    uint64_t byteCount;
+    bool endsWithNewline;
+    size_t transactionCount;
+    long long creditCents;
+    long long debitCents;
+    std::unordered_map<std::string, std::vector<uint64_t>> offsetsByAccount;
+
+public:
+    // Constructor
+    TransactionArchive();
+    TransactionArchive(const TransactionArchive&) = delete;
+    TransactionArchive& operator=(const TransactionArchive&) = delete;
+
+    // Loading; not safe against concurrent readers
+    bool load(const std::string& fileName, FileProfile& profile); // False if the file can't be read
+    void clear();
+
+    // Queries
+    size_t size() const;
+    bool empty() const;
+    uint64_t getByteCount() const;      // Length of the indexed prefix
+    bool needsLineBreak() const;        // The prefix ends mid-line; appends must start a new one
+    long long getCreditCents() const;
+    long long getDebitCents() const;    // Positive
+    size_t countFor(const std::string& accountNumber) const;
+
+    // Reading back
+    std::vector<std::shared_ptr<Transaction>> readAccount(const std::string& accountNumber) const; // Oldest first
+    // Newest first, one line at a time and nothing kept; stops when the visitor returns false
+    void visitAccount(const std::string& accountNumber, const std::function<bool(const Transaction&)>& visit) const;
+    void forEach(const std::function<void(const Transaction&)>& visit) const; // Every archived line, in file order
+
+    // Memory accounting (the offset index only; materialized histories belong to their accounts)
+    void addMemoryUsage(MemoryReport& report) const;
+};
+
+#endif // TRANSACTION_ARCHIVE_H
@@ -0,0 +1,145 @@
+#include "TransactionJournal.h"
+#include "Transaction.h"
+#include "LedgerStatistics.h"
+#include "MemoryAccounting.h"
+#include <stdexcept>
+#include <thread>
+
+TransactionJournal::TransactionJournal()
+    : chunks(new std::atomic<Chunk*>[kMaxChunks]), reserved(0), statistics(nullptr) {
+    for (size_t i = 0; i < kMaxChunks; ++i) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+TransactionJournal::~TransactionJournal() {
+    clear();
+}
+
+// Journal operations
+size_t TransactionJournal::append(std::shared_ptr<Transaction> transaction) {
+    size_t index = reserve(1);
+
+    if (statistics) {
+        statistics->recordPosting(transaction->getAmountMoney().getCents());
+    }
+    Slot& slot = chunkFor(index, true)->slots[index & (kChunkSize - 1)];
+    slot.transaction = std::move(transaction);
+    slot.ready.store(true, std::memory_order_release);
+    return index;
+}
+
+size_t TransactionJournal::appendBatch(std::vector<std::shared_ptr<Transaction>>& batch) {
+    // One reservation for the whole batch keeps it contiguous in the journal
+    size_t first = reserve(batch.size());
+    if (batch.empty()) {
+        return first;
+    }
+
+    Chunk* chunk = nullptr;
+    long long creditCents = 0;
+    long long debitCents = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        long long cents = batch[i]->getAmountMoney().getCents();
+        if (cents > 0) {
+            creditCents += cents;
+        } else {
+            debitCents -= cents;
+        }
+        size_t index = first + i;
+        if (!chunk || (index & (kChunkSize - 1)) == 0) {
+            chunk = chunkFor(index, true);
+        }
+        Slot& slot = chunk->slots[index & (kChunkSize - 1)];
+        slot.transaction = std::move(batch[i]);
+        slot.ready.store(true, std::memory_order_release);
+    }
+    if (statistics) {
+        statistics->recordPostings(batch.size(), creditCents, debitCents);
+    }
+    return first;
+}
+
+size_t TransactionJournal::size() const {
+    return reserved.load(std::memory_order_acquire);
+}
+
+bool TransactionJournal::empty() const {
+    return size() == 0;
+}
+
+std::shared_ptr<Transaction> TransactionJournal::at(size_t index) const {
+    Chunk* chunk = const_cast<TransactionJournal*>(this)->chunkFor(index, false);
+    const Slot& slot = chunk->slots[index & (kChunkSize - 1)];
+
+    // A reserved slot may still be mid-write; the writer is never blocked, so this is brief
+    while (!slot.ready.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    return slot.transaction;
+}
+
+void TransactionJournal::clear() {
+    size_t used = (reserved.load() + kChunkSize - 1) >> kChunkBits;
+    for (size_t i = 0; i < used && i < kMaxChunks; ++i) {
+        delete chunks[i].exchange(nullptr);
+    }
+    reserved.store(0);
+}
+
+void TransactionJournal::setStatistics(LedgerStatistics* statistics) {
+    this->statistics = statistics;
+}
+
+void TransactionJournal::addMemoryUsage(MemoryReport& report) const {
+    report.add(MemorySubsystem::Journal, 0, MemoryReport::allocationSize(kMaxChunks * sizeof(std::atomic<Chunk*>)));
+    size_t count = size();
+    for (size_t first = 0; first < count; first += kChunkSize) {
+        const Chunk* chunk = chunks[first >> kChunkBits].load(std::memory_order_acquire);
+        if (!chunk) {
+            continue;
+        }
+        report.add(MemorySubsystem::Journal, 1, MemoryReport::allocationSize(sizeof(Chunk)));
+        for (size_t i = first; i < count && i < first + kChunkSize; ++i) {
+            const Slot& slot = chunk->slots[i & (kChunkSize - 1)];
+            if (slot.ready.load(std::memory_order_acquire) && slot.transaction) {
+                slot.transaction->addMemoryUsage(report);
+            }
+        }
+    }
+}
+
+// Helper methods
+size_t TransactionJournal::reserve(size_t count) {
+    // Capacity is checked before the slots are claimed: a claimed slot that is
+    // never published would leave readers of that index waiting forever
+    size_t first = reserved.load(std::memory_order_relaxed);
+    do {
+        if (count > kChunkSize * kMaxChunks - first) {
+            throw std::length_error("Transaction journal is full");
+        }
+    } while (!reserved.compare_exchange_weak(first, first + count, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed));
+    return first;
+}
+
+TransactionJournal::Chunk* TransactionJournal::chunkFor(size_t index, bool create) {
+    std::atomic<Chunk*>& entry = chunks[index >> kChunkBits];
+    Chunk* chunk = entry.load(std::memory_order_acquire);
+    while (!chunk) {
+        if (!create) {
+            // Reserved by an appender that hasn't installed the chunk yet
+            std::this_thread::yield();
+            chunk = entry.load(std::memory_order_acquire);
+            continue;
+        }
+
+        Chunk* fresh = new Chunk();
+        if (entry.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+            chunk = fresh;
+        } else {
+            delete fresh; // Another appender won the race; chunk now holds its pointer
+        }
+    }
+    return chunk;
+}
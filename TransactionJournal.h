@@ -0,0 +1,70 @@
+#ifndef TRANSACTION_JOURNAL_H
+#define TRANSACTION_JOURNAL_H
+
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+class Transaction;
+class LedgerStatistics;
+class MemoryReport;
+
+// Bank-wide, append-only log of every posted transaction.
+//
+// Appends claim their slots with a compare-and-swap on the reserved count,
+// which refuses a claim past capacity before anything is taken, and
+// publish each slot with a per-slot flag, so writers never block each
+// other or readers. Entries never move once written, which lets a reader
+// pin a length and iterate that prefix while writers keep appending
+// behind it.
+class TransactionJournal {
+private:
+    static const size_t kChunkBits = 14;
+    static const size_t kChunkSize = size_t(1) << kChunkBits;
+    static const size_t kMaxChunks = size_t(1) << 18;
+
+    struct Slot {
+        std::shared_ptr<Transaction> transaction;
+        std::atomic<bool> ready{false};
+    };
+
+    struct Chunk {
+        Slot slots[kChunkSize];
+    };
+
+    std::unique_ptr<std::atomic<Chunk*>[]> chunks;
+    std::atomic<size_t> reserved;
+    LedgerStatistics* statistics; // Bank-wide totals every append is reported to (optional)
+
+public:
+    // Constructor and destructor
+    TransactionJournal();
+    ~TransactionJournal();
+    TransactionJournal(const TransactionJournal&) = delete;
+    TransactionJournal& operator=(const TransactionJournal&) = delete;
+
+    // Journal operations
+    size_t append(std::shared_ptr<Transaction> transaction);
+    size_t appendBatch(std::vector<std::shared_ptr<Transaction>>& batch); // Moves from batch; returns first index
+    size_t size() const;
+    bool empty() const;
+    std::shared_ptr<Transaction> at(size_t index) const;
+    void clear(); // Not safe against concurrent appends; leaves the statistics alone
+    void setStatistics(LedgerStatistics* statistics);
+    void addMemoryUsage(MemoryReport& report) const; // Chunks plus every transaction in them
+
+    // Visit entries [begin, end) in posting order
+    template <typename Visitor>
+    void forEach(size_t begin, size_t end, Visitor visit) const {
+        for (size_t i = begin; i < end; ++i) {
+            visit(at(i));
+        }
+    }
+
+private:
+    size_t reserve(size_t count); // Claims count slots, or throws length_error if they don't fit
+    Chunk* chunkFor(size_t index, bool create);
+};
+
+#endif // TRANSACTION_JOURNAL_H
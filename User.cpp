@@ -1,11 +1,10 @@
 #include "User.h"
+#include "IdGenerator.h"
+#include "PeriodClock.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
-#include <ctime>
-#include <random>
 #include <algorithm>
-#include <chrono>
 
 User::User() : isActive(true) {
     generateUserId();
@@ -105,23 +104,13 @@ void User::fromFileString(const std::string& data) {
 
 // Utility methods
 void User::generateUserId() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(100000, 999999);
-    userId = "U" + std::to_string(dis(gen));
+    userId = "U" + std::to_string(IdGenerator::shared().next(100000, 999999));
 }
 
 void User::generateAccountNumber() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(100000000, 999999999);
-    accountNumber = std::to_string(dis(gen));
+    accountNumber = std::to_string(IdGenerator::shared().next(100000000, 999999999));
 }
 
 std::string User::getCurrentDateTime() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    return PeriodClock::shared().timestamp();
 }
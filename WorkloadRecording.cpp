@@ -0,0 +1,268 @@
+#include "WorkloadRecording.h"
+#include "BankingSystem.h"
+#include "BankServer.h"
+#include "PeriodClock.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <filesystem>
+#include <ctime>
+
+namespace {
+
+const size_t kMaxExamples = 5;
+
+// Requests and responses are whitespace-separated tokens, some of them
+// colon-joined fields (ACCOUNTS); IDs are replaced field by field
+std::string substituteIds(const std::string& text, const std::unordered_map<std::string, std::string>& ids) {
+    if (ids.empty()) {
+        return text;
+    }
+    std::istringstream iss(text);
+    std::string token;
+    std::string result;
+    while (iss >> token) {
+        if (!result.empty()) {
+            result += ' ';
+        }
+        size_t fieldStart = 0;
+        while (true) {
+            size_t colon = token.find(':', fieldStart);
+            std::string field = token.substr(fieldStart, colon == std::string::npos ? std::string::npos : colon - fieldStart);
+            auto it = ids.find(field);
+            result += it == ids.end() ? field : it->second;
+            if (colon == std::string::npos) {
+                break;
+            }
+            result += ':';
+            fieldStart = colon + 1;
+        }
+    }
+    return result;
+}
+
+bool createsId(const std::string& command) {
+    return command == "REGISTER" || command == "LOGIN" || command == "OPEN" || command == "LOAN";
+}
+
+std::string secondToken(const std::string& text) {
+    std::istringstream iss(text);
+    std::string first, second;
+    iss >> first >> second;
+    return second;
+}
+
+bool copyDataFiles(const std::string& fromDirectory, const std::string& toDirectory,
+                   const std::vector<std::string>& dataFiles, std::string& error) {
+    namespace fs = std::filesystem;
+    for (const auto& file : dataFiles) {
+        fs::path source = fs::path(fromDirectory) / file;
+        std::error_code code;
+        if (!fs::exists(source, code)) {
+            continue; // e.g. no loan payments yet
+        }
+        fs::copy_file(source, fs::path(toDirectory) / file, fs::copy_options::overwrite_existing, code);
+        if (code) {
+            error = "Cannot copy " + source.string() + ": " + code.message();
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// WorkloadRecorder
+const char* const WorkloadRecorder::kLogFile = "operations.log";
+
+bool WorkloadRecorder::open(const std::string& directory, const std::vector<std::string>& dataFiles) {
+    std::error_code code;
+    std::filesystem::create_directories(directory, code);
+    if (code) {
+        error = "Cannot create " + directory + ": " + code.message();
+        return false;
+    }
+    if (!copyDataFiles(".", directory, dataFiles, error)) {
+        return false;
+    }
+    log.open((std::filesystem::path(directory) / kLogFile).string(), std::ios::trunc);
+    if (!log.is_open()) {
+        error = "Cannot write " + directory + "/" + kLogFile;
+        return false;
+    }
+    start = std::chrono::steady_clock::now();
+    log << "start " << static_cast<long long>(std::time(nullptr)) << "\n";
+    return true;
+}
+
+bool WorkloadRecorder::isOpen() const {
+    return log.is_open();
+}
+
+const std::string& WorkloadRecorder::getError() const {
+    return error;
+}
+
+void WorkloadRecorder::record(unsigned long long sessionId, const std::string& request, const std::string& response) {
+    if (!log.is_open()) {
+        return;
+    }
+    long long offset = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::string cleanRequest = request;
+    for (char& c : cleanRequest) {
+        if (c == '\t') {
+            c = ' '; // Same tokens to the protocol parser; tab is the field separator here
+        }
+    }
+    log << offset << " " << sessionId << " " << cleanRequest << "\t" << response << "\n";
+}
+
+void WorkloadRecorder::close() {
+    if (log.is_open()) {
+        log.close();
+    }
+}
+
+// ReplayReport
+double ReplayReport::getThroughput() const {
+    return seconds > 0.0 ? operations / seconds : 0.0;
+}
+
+void ReplayReport::print(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(3);
+    out << "Replayed " << operations << " requests from " << sessions << " sessions in " << seconds << "s ("
+        << std::setprecision(0) << getThroughput() << " requests/s); recorded traffic spanned "
+        << std::setprecision(1) << recordedSeconds << "s\n";
+    out << "Divergent responses: " << divergences << "\n";
+    for (const auto& example : examples) {
+        out << "  " << example << "\n";
+    }
+
+    out << "\nLatency (us):\n";
+    out << std::left << std::setw(14) << "Command" << std::right << std::setw(10) << "Count"
+        << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+        << std::setw(12) << "max" << "\n";
+    out << std::string(66, '-') << "\n";
+    out << std::setprecision(1);
+    auto printRow = [&out](const std::string& name, const LatencyHistogram& histogram) {
+        out << std::left << std::setw(14) << name << std::right
+            << std::setw(10) << histogram.getCount()
+            << std::setw(10) << histogram.percentile(50.0) / 1000.0
+            << std::setw(10) << histogram.percentile(99.0) / 1000.0
+            << std::setw(10) << histogram.percentile(99.9) / 1000.0
+            << std::setw(12) << histogram.getMax() / 1000.0 << "\n";
+    };
+    for (const auto& entry : latencyByCommand) {
+        printRow(entry.first, entry.second);
+    }
+    printRow("All", latency);
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// WorkloadReplayer
+WorkloadReplayer::WorkloadReplayer(const std::string& directory) : directory(directory), startSeconds(0) {}
+
+bool WorkloadReplayer::load(std::string& error) {
+    std::string path = (std::filesystem::path(directory) / WorkloadRecorder::kLogFile).string();
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "Cannot read " + path;
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line) || line.compare(0, 6, "start ") != 0) {
+        error = path + " is not a workload recording";
+        return false;
+    }
+    startSeconds = std::stoll(line.substr(6));
+
+    operations.clear();
+    size_t lineNumber = 1;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        size_t tab = line.find('\t');
+        std::istringstream iss(line.substr(0, tab));
+        Operation operation;
+        if (tab == std::string::npos || !(iss >> operation.offsetMicros >> operation.sessionId)) {
+            error = path + ":" + std::to_string(lineNumber) + ": malformed line";
+            return false;
+        }
+        iss >> std::ws;
+        std::getline(iss, operation.request);
+        operation.response = line.substr(tab + 1);
+        operations.push_back(std::move(operation));
+    }
+    return true;
+}
+
+bool WorkloadReplayer::restoreSnapshot(const std::vector<std::string>& dataFiles, std::string& error) const {
+    return copyDataFiles(directory, ".", dataFiles, error);
+}
+
+ReplayReport WorkloadReplayer::replay(BankingSystem& bank) const {
+    ReplayReport report;
+    BankServer server(bank);
+    std::unordered_map<unsigned long long, std::shared_ptr<Customer>> sessions;
+    std::unordered_map<std::string, std::string> ids; // Recorded ID -> ID handed out by this replay
+    PeriodClock& clock = PeriodClock::shared();
+    long long clockSecond = -1;
+
+    for (const auto& operation : operations) {
+        long long second = startSeconds + operation.offsetMicros / 1000000;
+        if (second != clockSecond) {
+            clock.setVirtualTime(second);
+            clockSecond = second;
+        }
+
+        std::string request = substituteIds(operation.request, ids);
+        std::shared_ptr<Customer>& session = sessions[operation.sessionId];
+        auto begin = std::chrono::steady_clock::now();
+        std::string response = server.handleRequest(request, session);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+
+        uint64_t nanoseconds = static_cast<uint64_t>(elapsed.count());
+        std::string command = request.substr(0, request.find(' '));
+        report.seconds += nanoseconds / 1e9;
+        report.latency.record(nanoseconds);
+        report.latencyByCommand[command].record(nanoseconds);
+
+        bool recordedOk = operation.response.compare(0, 3, "OK ") == 0;
+        bool replayedOk = response.compare(0, 3, "OK ") == 0;
+        if (createsId(command) && recordedOk && replayedOk) {
+            std::string recordedId = secondToken(operation.response);
+            std::string replayedId = secondToken(response);
+            if (recordedId != replayedId) {
+                ids[recordedId] = replayedId;
+            }
+        }
+        std::string expected = substituteIds(operation.response, ids);
+        if (command != "LATENCY" && command != "BATCH" && expected != response) {
+            report.divergences++;
+            if (report.examples.size() < kMaxExamples) {
+                report.examples.push_back(request + " -> expected \"" + expected + "\", got \"" + response + "\"");
+            }
+        }
+    }
+
+    report.operations = operations.size();
+    report.sessions = sessions.size();
+    report.recordedSeconds = operations.empty() ? 0.0 : operations.back().offsetMicros / 1e6;
+    report.success = true;
+    return report;
+}
+
+long long WorkloadReplayer::getStartSeconds() const {
+    return startSeconds;
+}
+
+size_t WorkloadReplayer::getOperationCount() const {
+    return operations.size();
+}
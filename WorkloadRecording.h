@@ -0,0 +1,90 @@
+#ifndef WORKLOAD_RECORDING_H
+#define WORKLOAD_RECORDING_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+
+#include "LatencyHistogram.h"
+
+class BankingSystem;
+
+// A recording is a directory holding a copy of the data files taken when
+// recording started, plus operations.log: a "start <epochSeconds>" line,
+// then one line per server request in the order the event loop served it:
+//   <offsetMicros> <sessionId> <request>\t<response>
+// Requests carry credentials just as customers.txt does; keep recordings
+// with the same care as the data files.
+
+// Captures the server's request stream
+class WorkloadRecorder {
+private:
+    std::ofstream log;
+    std::chrono::steady_clock::time_point start;
+    std::string error;
+
+public:
+    static const char* const kLogFile;
+
+    // Recording
+    bool open(const std::string& directory, const std::vector<std::string>& dataFiles); // Copies the data files first
+    bool isOpen() const;
+    const std::string& getError() const;
+    void record(unsigned long long sessionId, const std::string& request, const std::string& response);
+    void close();
+};
+
+// Outcome of one replay
+struct ReplayReport {
+    bool success = false;
+    std::string error;
+    size_t operations = 0;
+    size_t sessions = 0;
+    size_t divergences = 0;              // Responses that differ from the recorded ones
+    std::vector<std::string> examples;   // The first few divergences
+    double seconds = 0.0;                // Time spent executing requests
+    double recordedSeconds = 0.0;        // Span of the original traffic
+    LatencyHistogram latency;            // All requests, ns
+    std::map<std::string, LatencyHistogram> latencyByCommand;
+
+    double getThroughput() const;
+    void print(std::ostream& out) const;
+};
+
+// Re-executes a recording against a bank loaded from its data snapshot.
+//
+// Requests run one at a time in recorded order through the same protocol
+// handler the server uses, with the clock set to the recorded time of each
+// request. IDs the original run handed out (customer and account numbers,
+// loan IDs) are mapped to the ones the replay hands out, so later requests
+// that quote them still find their target; with a seeded IdGenerator the
+// replay is identical run after run.
+class WorkloadReplayer {
+private:
+    struct Operation {
+        long long offsetMicros;
+        unsigned long long sessionId;
+        std::string request;
+        std::string response;
+    };
+
+    std::string directory;
+    long long startSeconds;
+    std::vector<Operation> operations;
+
+public:
+    // Constructor
+    explicit WorkloadReplayer(const std::string& directory);
+
+    // Replay
+    bool load(std::string& error); // Reads operations.log
+    bool restoreSnapshot(const std::vector<std::string>& dataFiles, std::string& error) const; // Into the working directory
+    ReplayReport replay(BankingSystem& bank) const;
+    long long getStartSeconds() const;
+    size_t getOperationCount() const;
+};
+
+#endif // WORKLOAD_RECORDING_H
@@ -0,0 +1,17 @@
+#ifndef BENCH_THREADS_H
+#define BENCH_THREADS_H
+
+#include <vector>
+
+// Thread counts a scaling benchmark steps through: powers of two below the
+// maximum, then the maximum itself, so the last row always uses every thread
+inline std::vector<int> threadSteps(int maxThreads) {
+    std::vector<int> steps;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        steps.push_back(threads);
+    }
+    steps.push_back(maxThreads > 1 ? maxThreads : 1);
+    return steps;
+}
+
+#endif // BENCH_THREADS_H
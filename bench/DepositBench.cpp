@@ -0,0 +1,97 @@
+// Hot-account deposit benchmark.
+//
+// Many threads deposit into a single account (e.g. a merchant collection
+// account). Compares the lock-free integer-cents balance update behind
+// Account::deposit with a mutex-guarded double balance, and reports the full
+// Account::deposit rate (balance update plus transaction record).
+
+#include "../Account.h"
+#include "../Transaction.h"
+#include "BenchThreads.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Exposes the balance primitive without the transaction record
+struct HotAccount : Account {
+    HotAccount() : Account("BENCH", "Checking", 0.0) {}
+    using Account::credit;
+};
+
+struct LockedBalance {
+    mutex lock;
+    double balance = 0.0;
+
+    void deposit(double amount) {
+        lock_guard<mutex> guard(lock);
+        balance += amount;
+    }
+};
+
+template <typename Work>
+double runThreads(int threadCount, long long perThread, Work work) {
+    vector<thread> threads;
+    auto start = Clock::now();
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (long long i = 0; i < perThread; ++i) {
+                work(t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    long long perThread = argc > 1 ? atoll(argv[1]) : 2000000;
+    int maxThreads = static_cast<int>(thread::hardware_concurrency());
+    if (maxThreads < 1) maxThreads = 1;
+    if (argc > 2) maxThreads = atoi(argv[2]);
+
+    cout << "Deposits per thread: " << perThread << "\n";
+    cout << setw(8) << "threads" << setw(18) << "atomic cents/s" << setw(18) << "mutex+double/s"
+         << setw(22) << "Account::deposit/s" << setw(8) << "exact" << "\n";
+
+    for (int threads : threadSteps(maxThreads)) {
+        HotAccount hot;
+        double atomicSeconds = runThreads(threads, perThread, [&](int, long long) {
+            hot.credit(101);
+        });
+
+        LockedBalance locked;
+        double lockedSeconds = runThreads(threads, perThread, [&](int, long long) {
+            locked.deposit(1.01);
+        });
+
+        // Full deposits also build a Transaction, so run a tenth as many
+        long long fullPerThread = perThread / 10 > 0 ? perThread / 10 : 1;
+        Account account("BENCH", "Checking", 0.0);
+        double accountSeconds = runThreads(threads, fullPerThread, [&](int, long long) {
+            account.deposit(1.01);
+        });
+
+        double total = static_cast<double>(perThread) * threads;
+        double fullTotal = static_cast<double>(fullPerThread) * threads;
+        bool exact = hot.getBalanceCents() == perThread * threads * 101 &&
+                     account.getBalanceCents() == fullPerThread * threads * 101 &&
+                     account.getTransactionCount() == static_cast<size_t>(fullPerThread * threads);
+
+        cout << setw(8) << threads << fixed << setprecision(0)
+             << setw(18) << total / atomicSeconds
+             << setw(18) << total / lockedSeconds
+             << setw(22) << fullTotal / accountSeconds
+             << setw(8) << (exact ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Interest accrual benchmark.
+//
+// Kernel: monthly interest over contiguous balance/rate columns, computed
+// with the exact integer path, the AVX2 kernel, and the double formula the
+// accounts used before Money.
+//
+// Posting: the end-of-day interest job over real accounts, as a virtual
+// applyInterest() per account versus gather + kernel + bulk journal append.
+// Both runs start from identical books and must end with identical balances.
+
+#include "../Account.h"
+#include "../SavingsAccount.h"
+#include "../Transaction.h"
+#include "../TransactionJournal.h"
+#include "../InterestKernel.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+template <typename Work>
+double timeIt(Work work) {
+    auto start = Clock::now();
+    work();
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+void printRate(const string& name, size_t count, double seconds) {
+    cout << "  " << setw(28) << left << name << right << fixed << setprecision(1)
+         << setw(10) << static_cast<double>(count) / seconds / 1e6 << " M accounts/s"
+         << setw(10) << setprecision(3) << seconds << " s\n";
+}
+
+vector<shared_ptr<Account>> makeBook(size_t count, TransactionJournal& journal) {
+    mt19937_64 rng(7);
+    uniform_int_distribution<long long> cents(0, 5000000);
+    vector<shared_ptr<Account>> book;
+    book.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        shared_ptr<Account> account;
+        if (i % 2 == 0) {
+            account = make_shared<SavingsAccount>("BENCH");
+        } else {
+            account = make_shared<Account>("BENCH", "Checking");
+            account->setInterestRate(0.1);
+        }
+        account->setBalance(static_cast<double>(cents(rng)) / 100.0);
+        account->setJournal(&journal);
+        book.push_back(account);
+    }
+    return book;
+}
+
+string timestamp() {
+    time_t now = time(nullptr);
+    tm local{};
+    localtime_r(&now, &local);
+    char buffer[32];
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    return buffer;
+}
+
+int main(int argc, char* argv[]) {
+    size_t columnCount = argc > 1 ? static_cast<size_t>(atoll(argv[1])) : 10000000;
+    size_t bookCount = argc > 2 ? static_cast<size_t>(atoll(argv[2])) : 1000000;
+
+    // Kernel only
+    mt19937_64 rng(42);
+    uniform_int_distribution<long long> cents(1, 5000000);
+    vector<int64_t> balances(columnCount);
+    vector<int64_t> rates(columnCount);
+    vector<int32_t> periods(columnCount);
+    for (size_t i = 0; i < columnCount; ++i) {
+        balances[i] = cents(rng);
+        rates[i] = i % 2 == 0 ? Money::rateToMicros(2.5) : Money::rateToMicros(0.1);
+        periods[i] = i % 2 == 0 ? 12 : 1;
+    }
+    vector<int64_t> scalarOut(columnCount), kernelOut(columnCount);
+    vector<double> doubleOut(columnCount);
+
+    cout << "Kernel over " << columnCount << " accounts (AVX2 " << (InterestKernel::hasAvx2() ? "on" : "off") << ")\n";
+    printRate("double formula", columnCount, timeIt([&]() {
+        for (size_t i = 0; i < columnCount; ++i) {
+            doubleOut[i] = static_cast<double>(balances[i]) / 100.0 * (i % 2 == 0 ? 2.5 / 100.0 / 12.0 : 0.1 / 100.0);
+        }
+    }));
+    printRate("exact integer (scalar)", columnCount, timeIt([&]() {
+        InterestKernel::accrueScalar(balances.data(), rates.data(), periods.data(), scalarOut.data(), columnCount);
+    }));
+    printRate("exact kernel (dispatch)", columnCount, timeIt([&]() {
+        InterestKernel::accrue(balances.data(), rates.data(), periods.data(), kernelOut.data(), columnCount);
+    }));
+    cout << "  kernel matches scalar: " << (kernelOut == scalarOut ? "yes" : "NO") << "\n\n";
+
+    // Full posting job
+    cout << "Posting interest to " << bookCount << " accounts\n";
+    TransactionJournal oldJournal, newJournal;
+    auto oldBook = makeBook(bookCount, oldJournal);
+    auto newBook = makeBook(bookCount, newJournal);
+
+    printRate("virtual applyInterest loop", bookCount, timeIt([&]() {
+        for (auto& account : oldBook) {
+            if (account->isActive() && account->getBalanceCents() > 0) {
+                account->applyInterest();
+            }
+        }
+    }));
+
+    printRate("kernel + bulk append", bookCount, timeIt([&]() {
+        const string date = timestamp();
+        vector<size_t> eligible;
+        vector<int64_t> bookBalances, bookRates;
+        vector<int32_t> bookPeriods;
+        for (size_t i = 0; i < newBook.size(); ++i) {
+            const Account& account = *newBook[i];
+            if (account.isActive() && account.getBalanceCents() > 0) {
+                eligible.push_back(i);
+                bookBalances.push_back(account.getBalanceCents());
+                bookRates.push_back(Money::rateToMicros(account.getInterestRate()));
+                bookPeriods.push_back(account.getInterestPeriodsPerYear());
+            }
+        }
+        vector<int64_t> interest(eligible.size());
+        InterestKernel::accrue(bookBalances.data(), bookRates.data(), bookPeriods.data(), interest.data(), eligible.size());
+        vector<shared_ptr<Transaction>> postings;
+        postings.reserve(eligible.size());
+        for (size_t k = 0; k < eligible.size(); ++k) {
+            if (interest[k] > 0) {
+                postings.push_back(newBook[eligible[k]]->postInterest(Money::fromCents(interest[k]), date));
+            }
+        }
+        newJournal.appendBatch(postings);
+    }));
+
+    bool same = oldJournal.size() == newJournal.size();
+    for (size_t i = 0; same && i < bookCount; ++i) {
+        same = oldBook[i]->getBalanceCents() == newBook[i]->getBalanceCents();
+    }
+    cout << "  balances and posting counts match: " << (same ? "yes" : "NO")
+         << " (" << newJournal.size() << " postings)\n";
+    return 0;
+}
@@ -0,0 +1,265 @@
+// Core ledger operation benchmark.
+//
+// Builds a bank of N checking accounts for each dataset size and measures
+// the operations every request path goes through: Account::deposit,
+// withdraw and transfer, BankingSystem::findAccount (hits and misses) and
+// a full saveData. Each result reports ns/op, heap allocations and bytes
+// per op (counted by replacing the global operator new) and throughput.
+//
+// A human-readable table goes to stderr and the results to stdout (or
+// --out FILE) as JSON, so runs before and after a change can be diffed.
+// saveData writes into a scratch directory that is removed afterwards.
+
+#include "../BankingSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Allocation counting
+namespace {
+atomic<size_t> allocationCount(0);
+atomic<size_t> allocationBytes(0);
+}
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocationBytes.fetch_add(size, memory_order_relaxed);
+    if (void* memory = malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+struct BenchResult {
+    string operation;
+    size_t accounts;
+    size_t ops;
+    size_t succeeded;
+    double seconds;
+    size_t allocations;
+    size_t bytes;
+
+    double nsPerOp() const { return ops ? seconds * 1e9 / ops : 0.0; }
+    double opsPerSecond() const { return seconds > 0.0 ? ops / seconds : 0.0; }
+    double allocationsPerOp() const { return ops ? static_cast<double>(allocations) / ops : 0.0; }
+    double bytesPerOp() const { return ops ? static_cast<double>(bytes) / ops : 0.0; }
+};
+
+// Runs work(i) for i in [0, ops) and counts successes, time and allocations
+template <typename Work>
+BenchResult measure(const string& operation, size_t accounts, size_t ops, Work work) {
+    size_t allocationsBefore = allocationCount.load();
+    size_t bytesBefore = allocationBytes.load();
+    size_t succeeded = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        succeeded += work(i) ? 1 : 0;
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    return BenchResult{operation, accounts, ops, succeeded, seconds,
+                       allocationCount.load() - allocationsBefore, allocationBytes.load() - bytesBefore};
+}
+
+vector<size_t> parseSizes(const string& text) {
+    vector<size_t> sizes;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) {
+            sizes.push_back(static_cast<size_t>(atoll(item.c_str())));
+        }
+    }
+    return sizes;
+}
+
+string jsonEscape(const string& text) {
+    string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void printRow(const BenchResult& result) {
+    cerr << "  " << left << setw(30) << result.operation << right << fixed
+         << setprecision(1) << setw(10) << result.nsPerOp() << " ns/op"
+         << setprecision(2) << setw(8) << result.allocationsPerOp() << " allocs/op"
+         << setprecision(0) << setw(9) << result.bytesPerOp() << " B/op"
+         << setprecision(2) << setw(9) << result.opsPerSecond() / 1e6 << " Mops/s\n";
+}
+
+void writeJson(ostream& out, const vector<BenchResult>& results, size_t ops) {
+    out << "{\n";
+    out << "  \"benchmark\": \"ledger\",\n";
+    out << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n";
+    out << "  \"ops_per_size\": " << ops << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << fixed << setprecision(3);
+        out << "    {\"operation\": \"" << jsonEscape(r.operation) << "\", \"accounts\": " << r.accounts
+            << ", \"ops\": " << r.ops << ", \"succeeded\": " << r.succeeded
+            << ", \"seconds\": " << setprecision(6) << r.seconds
+            << ", \"ns_per_op\": " << setprecision(1) << r.nsPerOp()
+            << ", \"allocs_per_op\": " << setprecision(3) << r.allocationsPerOp()
+            << ", \"bytes_per_op\": " << setprecision(1) << r.bytesPerOp()
+            << ", \"ops_per_sec\": " << setprecision(0) << r.opsPerSecond() << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+void runSize(size_t accountCount, size_t ops, vector<BenchResult>& results) {
+    cerr << "\n" << accountCount << " accounts\n";
+
+    BankingSystem bank;
+    vector<shared_ptr<Account>> accounts;
+    vector<string> numbers;
+    accounts.reserve(accountCount);
+    numbers.reserve(accountCount);
+
+    // One customer per four accounts; limits lifted so withdrawals measure the posting, not a decline
+    shared_ptr<Customer> customer;
+    results.push_back(measure("BankingSystem::createAccount", accountCount, accountCount, [&](size_t i) {
+        if (i % 4 == 0) {
+            customer = bank.createCustomer("Bench Customer", "bench@example.com", "0000000000",
+                                           "1 Bench Street", "password");
+        }
+        auto account = bank.createAccount(customer->getUserId(), "Checking", 1000.0);
+        account->setDailyWithdrawalLimit(Money::fromCents(INT64_C(1) << 40));
+        account->setMonthlyWithdrawalLimit(Money::fromCents(INT64_C(1) << 40));
+        accounts.push_back(account);
+        numbers.push_back(account->getAccountNumber());
+        return true;
+    }));
+    printRow(results.back());
+
+    // Same random picks for every operation so sizes compare like for like
+    mt19937_64 rng(42);
+    uniform_int_distribution<size_t> pick(0, accountCount - 1);
+    vector<size_t> first(ops), second(ops);
+    for (size_t i = 0; i < ops; ++i) {
+        first[i] = pick(rng);
+        second[i] = pick(rng);
+    }
+    vector<string> missing(ops);
+    for (size_t i = 0; i < ops; ++i) {
+        missing[i] = "X" + numbers[first[i]];
+    }
+
+    const Money amount = Money::fromCents(100);
+    results.push_back(measure("Account::deposit", accountCount, ops, [&](size_t i) {
+        return accounts[first[i]]->deposit(amount);
+    }));
+    printRow(results.back());
+
+    results.push_back(measure("Account::withdraw", accountCount, ops, [&](size_t i) {
+        return accounts[first[i]]->withdraw(amount);
+    }));
+    printRow(results.back());
+
+    results.push_back(measure("Account::transfer", accountCount, ops, [&](size_t i) {
+        return accounts[first[i]]->transfer(*accounts[second[i]], amount);
+    }));
+    printRow(results.back());
+
+    results.push_back(measure("BankingSystem::findAccount", accountCount, ops, [&](size_t i) {
+        return bank.findAccount(numbers[first[i]]) != nullptr;
+    }));
+    printRow(results.back());
+
+    results.push_back(measure("BankingSystem::findAccount miss", accountCount, ops, [&](size_t i) {
+        return bank.findAccount(missing[i]) == nullptr;
+    }));
+    printRow(results.back());
+
+    // One full save; the op is one account written (customers and transactions ride along)
+    auto start = Clock::now();
+    size_t allocationsBefore = allocationCount.load();
+    size_t bytesBefore = allocationBytes.load();
+    bank.saveData();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    results.push_back(BenchResult{"BankingSystem::saveData", accountCount, accountCount, accountCount, seconds,
+                                  allocationCount.load() - allocationsBefore, allocationBytes.load() - bytesBefore});
+    printRow(results.back());
+
+    bank.clearData(); // Nothing left for the destructor's save to write
+}
+
+int main(int argc, char* argv[]) {
+    string sizeList = "1000,10000,100000,1000000";
+    size_t ops = 200000;
+    string outputFile;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc) sizeList = argv[++i];
+        else if (arg == "--ops" && i + 1 < argc) ops = static_cast<size_t>(atoll(argv[++i]));
+        else if (arg == "--out" && i + 1 < argc) outputFile = argv[++i];
+        else {
+            cerr << "Usage: " << argv[0] << " [--sizes 1000,10000,...] [--ops N] [--out FILE]\n";
+            return 1;
+        }
+    }
+    vector<size_t> sizes = parseSizes(sizeList);
+    if (sizes.empty() || ops == 0) {
+        cerr << "Nothing to run.\n";
+        return 1;
+    }
+
+    // saveData writes to the working directory; keep the real data files out of reach
+    string originalDirectory = filesystem::current_path().string();
+    char scratchTemplate[] = "/tmp/oyanib_bench_XXXXXX";
+    if (!mkdtemp(scratchTemplate) || chdir(scratchTemplate) != 0) {
+        cerr << "Cannot create a scratch directory.\n";
+        return 1;
+    }
+
+    cerr << "Ops per size: " << ops << "\n";
+    vector<BenchResult> results;
+    for (size_t size : sizes) {
+        if (size > 0) {
+            runSize(size, ops, results);
+        }
+    }
+
+    if (chdir(originalDirectory.c_str()) != 0) {
+        cerr << "Cannot return to " << originalDirectory << "\n";
+    }
+    error_code error;
+    filesystem::remove_all(scratchTemplate, error);
+
+    if (outputFile.empty()) {
+        writeJson(cout, results, ops);
+    } else {
+        ofstream out(outputFile);
+        writeJson(out, results, ops);
+        cerr << "\nResults written to " << outputFile << "\n";
+    }
+    return 0;
+}
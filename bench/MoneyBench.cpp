@@ -0,0 +1,128 @@
+// Money representation benchmark.
+//
+// Runs the same ledger workloads on integer cents (Money) and on double
+// dollars: summing a column of postings, replaying postings into a running
+// balance, and computing monthly interest for a book of accounts. Reports
+// throughput and how far the double path drifts from the exact result.
+
+#include "../Money.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+template <typename Work>
+double timeIt(Work work) {
+    auto start = Clock::now();
+    work();
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Keeps the optimizer from discarding a result
+template <typename T>
+void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+void printRow(const string& name, double count, double moneySeconds, double doubleSeconds, const string& drift) {
+    cout << setw(20) << left << name << right << fixed << setprecision(1)
+         << setw(14) << count / moneySeconds / 1e6
+         << setw(14) << count / doubleSeconds / 1e6
+         << setw(10) << setprecision(2) << doubleSeconds / moneySeconds << "x"
+         << "  " << drift << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(atoll(argv[1])) : 20000000;
+
+    // Postings between -$500.00 and +$500.00, always whole cents
+    mt19937_64 rng(42);
+    uniform_int_distribution<long long> centsDist(-50000, 50000);
+    vector<Money> moneyPostings(count);
+    vector<double> doublePostings(count);
+    for (size_t i = 0; i < count; ++i) {
+        long long cents = centsDist(rng);
+        moneyPostings[i] = Money::fromCents(cents);
+        doublePostings[i] = static_cast<double>(cents) / 100.0;
+    }
+
+    cout << "Postings: " << count << "\n";
+    cout << setw(20) << left << "workload" << right << setw(14) << "Money M/s" << setw(14) << "double M/s"
+         << setw(11) << "speedup" << "  double error\n";
+
+    // Column sum
+    Money moneyTotal;
+    double moneySeconds = timeIt([&]() {
+        moneyTotal = Money::sum(moneyPostings.data(), moneyPostings.size());
+    });
+    double doubleTotal = 0.0;
+    double doubleSeconds = timeIt([&]() {
+        for (double amount : doublePostings) {
+            doubleTotal += amount;
+        }
+    });
+    keep(moneyTotal);
+    keep(doubleTotal);
+    long long sumError = llround(doubleTotal * 100.0) - moneyTotal.getCents();
+    printRow("sum", static_cast<double>(count), moneySeconds, doubleSeconds,
+             to_string(sumError) + " cents (exact " + moneyTotal.toString() + ")");
+
+    // Replay into a running balance, checking a floor like a withdrawal would
+    Money moneyBalance = Money::fromCents(100000000);
+    size_t moneyDeclined = 0;
+    moneySeconds = timeIt([&]() {
+        for (Money amount : moneyPostings) {
+            Money next = moneyBalance + amount;
+            if (next >= Money()) moneyBalance = next; else ++moneyDeclined;
+        }
+    });
+    double doubleBalance = 1000000.0;
+    size_t doubleDeclined = 0;
+    doubleSeconds = timeIt([&]() {
+        for (double amount : doublePostings) {
+            double next = doubleBalance + amount;
+            if (next >= 0.0) doubleBalance = next; else ++doubleDeclined;
+        }
+    });
+    keep(moneyBalance);
+    keep(doubleBalance);
+    long long replayError = llround(doubleBalance * 100.0) - moneyBalance.getCents();
+    printRow("replay", static_cast<double>(count), moneySeconds, doubleSeconds,
+             to_string(replayError) + " cents, declines " + to_string(moneyDeclined) + "/" +
+             to_string(doubleDeclined));
+
+    // Monthly interest at 2.5% on every balance in the column
+    vector<Money> moneyBalances(count);
+    vector<double> doubleBalances(count);
+    for (size_t i = 0; i < count; ++i) {
+        moneyBalances[i] = moneyPostings[i].abs() * 100;
+        doubleBalances[i] = fabs(doublePostings[i]) * 100.0;
+    }
+    vector<Money> moneyInterest(count);
+    vector<double> doubleInterest(count);
+    moneySeconds = timeIt([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            moneyInterest[i] = moneyBalances[i].interest(2.5, 12);
+        }
+    });
+    doubleSeconds = timeIt([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            doubleInterest[i] = round(doubleBalances[i] * 2.5 / 100.0 / 12.0 * 100.0) / 100.0;
+        }
+    });
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (llround(doubleInterest[i] * 100.0) != moneyInterest[i].getCents()) {
+            ++mismatches;
+        }
+    }
+    printRow("interest", static_cast<double>(count), moneySeconds, doubleSeconds,
+             to_string(mismatches) + " results differ (half-even vs half-up)");
+    return 0;
+}
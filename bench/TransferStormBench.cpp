@@ -0,0 +1,376 @@
+// Transfer-storm stress benchmark.
+//
+// Threads hammer a shared set of checking and savings accounts with
+// Account::transfer, mixed with deposits, withdrawals and interest
+// postings, picking accounts uniformly or from a Zipf distribution so a few
+// hot accounts take most of the traffic. Throughput is reported for each
+// thread count and skew.
+//
+// A checker thread pauses the workers at regular intervals and verifies the
+// ledger while nothing is in flight:
+//   - money is conserved: the account balances add up to the opening
+//     balances plus the deposits, withdrawals and interest the workers
+//     report, and LedgerStatistics agrees with the scan
+//   - no balance is below the account's minimum balance
+//   - no savings account has more monthly transactions than its cap
+// After each run every savings history is also counted, so a debit that
+// slipped past the cap shows up even if the counter itself was wrong.
+//
+// Withdrawal limits are lifted so transfers keep moving money instead of
+// being declined after the first few hundred dollars of a day; the savings
+// monthly cap stays, as one of the invariants. Exits non-zero on any
+// violation.
+
+#include "../Account.h"
+#include "../SavingsAccount.h"
+#include "../Transaction.h"
+#include "../LedgerStatistics.h"
+#include "../MetricsRegistry.h"
+#include "BenchThreads.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+namespace {
+
+const long long kUnlimitedCents = 1000000000000LL; // Fits the packed withdrawal windows
+const long long kCheckPollOps = 256;               // Workers look for a pause request this often
+
+struct Options {
+    size_t accounts = 100000;
+    long long opsPerThread = 50000;
+    int maxThreads = 0;
+    vector<double> skews{0.0, 0.99, 1.2};
+    int savingsPercent = 25;
+    int checkIntervalMs = 50;
+    uint64_t seed = 42;
+};
+
+// Zipf(s) over [0, n): rank r is drawn with weight 1 / (r + 1)^s; s = 0 is uniform
+class ZipfSampler {
+private:
+    vector<double> cumulative;
+
+public:
+    ZipfSampler(size_t n, double s) : cumulative(n) {
+        double total = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            total += 1.0 / pow(static_cast<double>(i + 1), s);
+            cumulative[i] = total;
+        }
+        for (auto& value : cumulative) {
+            value /= total;
+        }
+    }
+
+    size_t sample(mt19937_64& gen) const {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(gen);
+        size_t index = lower_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+        return min(index, cumulative.size() - 1);
+    }
+
+    // Share of draws landing on the hottest account
+    double topShare() const {
+        return cumulative.empty() ? 0.0 : cumulative.front();
+    }
+};
+
+// Money entering or leaving the account set, as seen by one worker
+struct alignas(64) WorkerFlows {
+    long long depositedCents = 0;
+    long long withdrawnCents = 0;
+    long long interestCents = 0;
+    long long transfers = 0;
+    long long transfersDeclined = 0;
+    long long operations = 0;
+};
+
+struct Ledger {
+    LedgerStatistics statistics;
+    vector<unique_ptr<Account>> accounts;
+    vector<SavingsAccount*> savings;
+    long long openingCents = 0;
+
+    Ledger(size_t count, int savingsPercent, uint64_t seed) {
+        mt19937_64 gen(seed);
+        uniform_int_distribution<long long> opening(100000, 500000); // $1,000 - $5,000
+        accounts.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            double balance = Account::fromCents(opening(gen));
+            unique_ptr<Account> account;
+            if (static_cast<int>(gen() % 100) < savingsPercent) {
+                auto saving = make_unique<SavingsAccount>("STORM", balance);
+                savings.push_back(saving.get());
+                account = move(saving);
+            } else {
+                account = make_unique<Account>("STORM", "Checking", balance);
+            }
+            account->setDailyWithdrawalLimit(Money::fromCents(kUnlimitedCents));
+            account->setMonthlyWithdrawalLimit(Money::fromCents(kUnlimitedCents));
+            account->setStatistics(&statistics);
+            openingCents += account->getBalanceCents();
+            accounts.push_back(move(account));
+        }
+    }
+};
+
+struct RunResult {
+    double seconds = 0.0;  // Excluding time spent paused for checks
+    long long operations = 0;
+    long long transfers = 0;
+    long long transfersDeclined = 0;
+    int checks = 0;
+    vector<string> violations;
+};
+
+// Verifies the invariants; callers guarantee no operation is in flight
+void checkLedger(const Ledger& ledger, const vector<WorkerFlows>& flows, RunResult& result) {
+    long long expected = ledger.openingCents;
+    for (const auto& flow : flows) {
+        expected += flow.depositedCents - flow.withdrawnCents + flow.interestCents;
+    }
+
+    long long scanned = 0;
+    for (const auto& account : ledger.accounts) {
+        long long balance = account->getBalanceCents();
+        scanned += balance;
+        if (balance < account->getMinimumBalanceMoney().getCents()) {
+            result.violations.push_back(account->getAccountNumber() + " is below its minimum balance: " +
+                                        Money::fromCents(balance).toString());
+        }
+    }
+    for (const SavingsAccount* saving : ledger.savings) {
+        if (saving->getMonthlyTransactions() > saving->getMaxMonthlyTransactions()) {
+            result.violations.push_back(saving->getAccountNumber() + " made " +
+                                        to_string(saving->getMonthlyTransactions()) + " transactions this month, cap " +
+                                        to_string(saving->getMaxMonthlyTransactions()));
+        }
+    }
+    if (scanned != expected) {
+        result.violations.push_back("Balances add up to " + Money::fromCents(scanned).toString() + ", expected " +
+                                    Money::fromCents(expected).toString());
+    }
+    long long tracked = ledger.statistics.getTotals().balance.getCents();
+    if (tracked != scanned) {
+        result.violations.push_back("LedgerStatistics balance " + Money::fromCents(tracked).toString() +
+                                    " differs from the scan " + Money::fromCents(scanned).toString());
+    }
+    result.checks++;
+}
+
+// Savings debits recorded in the history, which the cap bounds independently of the counter
+void checkSavingsHistories(const Ledger& ledger, RunResult& result) {
+    for (const SavingsAccount* saving : ledger.savings) {
+        int debits = 0;
+        saving->forEachTransaction([&debits](const Transaction& transaction) {
+            if (transaction.getType() == "Withdrawal" || transaction.getType() == "Transfer Out") {
+                debits++;
+            }
+            return true;
+        });
+        if (debits > saving->getMaxMonthlyTransactions()) {
+            result.violations.push_back(saving->getAccountNumber() + " history holds " + to_string(debits) +
+                                        " debits, cap " + to_string(saving->getMaxMonthlyTransactions()));
+        }
+    }
+}
+
+RunResult runStorm(const Options& options, int threadCount, const ZipfSampler& sampler, uint64_t seed) {
+    Ledger ledger(options.accounts, options.savingsPercent, seed);
+    vector<WorkerFlows> flows(threadCount);
+    RunResult result;
+
+    atomic<bool> pauseRequested(false);
+    atomic<int> parked(0);
+    atomic<int> finished(0);
+    const string interestDate = "2026-01-31 23:59:59";
+
+    auto worker = [&](int index) {
+        mt19937_64 gen(seed * 1000003 + index);
+        uniform_int_distribution<long long> amount(100, 10000); // $1 - $100
+        uniform_int_distribution<int> operation(0, 999);
+        WorkerFlows& flow = flows[index];
+
+        for (long long i = 0; i < options.opsPerThread; ++i) {
+            if (i % kCheckPollOps == 0 && pauseRequested.load(memory_order_acquire)) {
+                parked.fetch_add(1, memory_order_acq_rel);
+                while (pauseRequested.load(memory_order_acquire)) {
+                    this_thread::yield();
+                }
+                parked.fetch_sub(1, memory_order_acq_rel);
+            }
+
+            Account& account = *ledger.accounts[sampler.sample(gen)];
+            int pick = operation(gen);
+            long long cents = amount(gen);
+            if (pick < 700) {
+                Account& target = *ledger.accounts[sampler.sample(gen)];
+                if (&target == &account) {
+                    continue; // Self-transfers move nothing
+                }
+                if (account.transfer(target, Money::fromCents(cents))) {
+                    flow.transfers++;
+                } else {
+                    flow.transfersDeclined++;
+                }
+            } else if (pick < 850) {
+                if (account.deposit(Money::fromCents(cents))) {
+                    flow.depositedCents += cents;
+                }
+            } else if (pick < 995) {
+                if (account.withdraw(Money::fromCents(cents))) {
+                    flow.withdrawnCents += cents;
+                }
+            } else {
+                Money interest = account.calculateInterest();
+                if (interest > Money()) {
+                    account.postInterest(interest, interestDate);
+                    flow.interestCents += interest.getCents();
+                }
+            }
+            flow.operations++;
+        }
+        finished.fetch_add(1, memory_order_acq_rel);
+    };
+
+    double pausedSeconds = 0.0;
+    auto start = Clock::now();
+    vector<thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back(worker, t);
+    }
+
+    while (finished.load(memory_order_acquire) < threadCount) {
+        this_thread::sleep_for(chrono::milliseconds(options.checkIntervalMs));
+        auto pauseStart = Clock::now();
+        pauseRequested.store(true, memory_order_release);
+        while (parked.load(memory_order_acquire) + finished.load(memory_order_acquire) < threadCount) {
+            this_thread::yield();
+        }
+        checkLedger(ledger, flows, result);
+        pauseRequested.store(false, memory_order_release);
+        pausedSeconds += chrono::duration<double>(Clock::now() - pauseStart).count();
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    result.seconds = chrono::duration<double>(Clock::now() - start).count() - pausedSeconds;
+
+    checkLedger(ledger, flows, result);
+    checkSavingsHistories(ledger, result);
+    for (const auto& flow : flows) {
+        result.operations += flow.operations;
+        result.transfers += flow.transfers;
+        result.transfersDeclined += flow.transfersDeclined;
+    }
+    return result;
+}
+
+vector<double> parseSkews(const string& text) {
+    vector<double> skews;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) {
+            skews.push_back(atof(item.c_str()));
+        }
+    }
+    return skews;
+}
+
+string skewName(double skew) {
+    if (skew == 0.0) {
+        return "uniform";
+    }
+    ostringstream oss;
+    oss << "zipf " << skew;
+    return oss.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--accounts" && i + 1 < argc) options.accounts = static_cast<size_t>(atoll(argv[++i]));
+        else if (arg == "--ops" && i + 1 < argc) options.opsPerThread = atoll(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) options.maxThreads = atoi(argv[++i]);
+        else if (arg == "--skews" && i + 1 < argc) options.skews = parseSkews(argv[++i]);
+        else if (arg == "--savings" && i + 1 < argc) options.savingsPercent = atoi(argv[++i]);
+        else if (arg == "--check-ms" && i + 1 < argc) options.checkIntervalMs = atoi(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc) options.seed = strtoull(argv[++i], nullptr, 10);
+        else {
+            cerr << "Usage: " << argv[0] << " [--accounts N] [--ops N per thread] [--threads MAX]"
+                 << " [--skews 0,0.99,1.2] [--savings PERCENT] [--check-ms N] [--seed N]\n"
+                 << "A skew of 0 picks accounts uniformly; larger values concentrate traffic on hot accounts.\n";
+            return 1;
+        }
+    }
+    if (options.accounts < 2 || options.opsPerThread < 1 || options.skews.empty()) {
+        cerr << "Need at least 2 accounts, 1 operation and one skew\n";
+        return 1;
+    }
+    if (options.maxThreads < 1) {
+        options.maxThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    }
+    if (options.checkIntervalMs < 1) {
+        options.checkIntervalMs = 1;
+    }
+
+    cout << "Accounts: " << options.accounts << " (" << options.savingsPercent << "% savings), "
+         << options.opsPerThread << " operations per thread: 70% transfers, 15% deposits, "
+         << "14.5% withdrawals, 0.5% interest postings\n";
+    cout << left << setw(12) << "skew" << right << setw(8) << "threads" << setw(14) << "ops/s"
+         << setw(16) << "transfers/s" << setw(11) << "declined" << setw(8) << "checks"
+         << setw(12) << "invariants" << "\n";
+    cout << string(81, '-') << "\n";
+
+    size_t totalViolations = 0;
+    for (double skew : options.skews) {
+        ZipfSampler sampler(options.accounts, skew);
+        for (int threads : threadSteps(options.maxThreads)) {
+            RunResult result = runStorm(options, threads, sampler, options.seed + threads);
+            long long attempted = result.transfers + result.transfersDeclined;
+            double declined = attempted > 0 ? 100.0 * result.transfersDeclined / attempted : 0.0;
+
+            cout << left << setw(12) << skewName(skew) << right << setw(8) << threads << fixed << setprecision(0)
+                 << setw(14) << result.operations / result.seconds
+                 << setw(16) << result.transfers / result.seconds
+                 << setw(10) << setprecision(1) << declined << "%"
+                 << setw(8) << result.checks
+                 << setw(12) << (result.violations.empty() ? "ok" : "VIOLATED") << "\n";
+            for (size_t i = 0; i < result.violations.size() && i < 5; ++i) {
+                cout << "    " << result.violations[i] << "\n";
+            }
+            totalViolations += result.violations.size();
+        }
+        if (skew > 0.0) {
+            cout << "  (hottest account takes " << setprecision(1) << 100.0 * sampler.topShare()
+                 << "% of picks)\n";
+        }
+    }
+
+    BankMetrics& metrics = BankMetrics::shared();
+    cout << "\nDeclined debits: " << metrics.declinedMinimumBalance.get() << " below minimum balance, "
+         << metrics.declinedMonthlyCap.get() << " over the savings monthly cap\n";
+    if (totalViolations > 0) {
+        cout << totalViolations << " invariant violations\n";
+        return 2;
+    }
+    return 0;
+}
@@ -11,14 +11,213 @@
 #include <random>
 #include <chrono>
 #include <thread>
+#include <csignal>
+#include <cstring>
+#include <cstdlib>
+#include <filesystem>
+#include <unistd.h>
 
 #include "BankingSystem.h"
+#include "BankServer.h"
 #include "Account.h"
 #include "Transaction.h"
 #include "User.h"
+#include "DatasetGenerator.h"
+#include "ThreadPool.h"
+#include "PeriodClock.h"
+#include "Tracer.h"
+#include "IdGenerator.h"
+#include "WorkloadRecording.h"
+#include "MetricsRegistry.h"
 
 using namespace std;
 
+static BankServer* activeServer = nullptr;
+
+void handleShutdownSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+void showUsage(const char* program) {
+    cout << "Usage: " << program << " [--server [--socket PATH | --port N]] | --generate [options]\n";
+    cout << "  (no arguments)   Interactive terminal banking\n";
+    cout << "  --server         Serve the line protocol (default socket: oyanib_bank.sock)\n";
+    cout << "  --socket PATH    Listen on a Unix domain socket\n";
+    cout << "  --port N         Listen on 127.0.0.1:N\n";
+    cout << "  --customer-rate R[:B]  Admit R transactions/s per customer, bursts of B\n";
+    cout << "  --global-rate R[:B]    Admit R transactions/s across all customers\n";
+    cout << "  --record DIR     With --server: snapshot the data files into DIR and log every request\n";
+    cout << "  --replay DIR     Re-run a recording deterministically and report throughput and latency\n";
+    cout << "  --trace FILE     Record internal spans and write them as Chrome trace JSON on exit\n";
+    cout << "  --metrics-file FILE    Rewrite Prometheus metrics to FILE every 5 seconds\n";
+    cout << "  --generate       Write a synthetic dataset in place of the data files, then exit\n";
+    cout << "    --customers N --accounts N --transactions N --loans N  Dataset size\n";
+    cout << "    --seed N       Same seed, same files (default 42); also seeds --replay IDs\n";
+    cout << "    --as-of DATE   Last day of activity, YYYY-MM-DD (default today)\n";
+    cout << "    --output DIR   Directory to write to (default .)\n";
+}
+
+// Traces from startup and writes the file when main returns, after the bank's final save
+class TraceSession {
+private:
+    string fileName;
+
+public:
+    explicit TraceSession(const string& fileName) : fileName(fileName) {
+        if (!fileName.empty()) {
+            Tracer::shared().start();
+        }
+    }
+
+    ~TraceSession() {
+        if (fileName.empty()) {
+            return;
+        }
+        Tracer::shared().stop();
+        if (Tracer::shared().writeChromeTrace(fileName)) {
+            cout << "Trace written to " << fileName << " (" << Tracer::shared().getEventCount() << " spans)\n";
+        } else {
+            cerr << "Cannot write trace to " << fileName << "\n";
+        }
+    }
+};
+
+// Keeps the metrics file fresh while the bank runs; the last write happens before the bank goes away
+class MetricsFileSession {
+private:
+    bool active;
+
+public:
+    explicit MetricsFileSession(const string& fileName) : active(!fileName.empty()) {
+        if (active) {
+            MetricsRegistry::shared().startFileExporter(fileName, 5);
+        }
+    }
+
+    ~MetricsFileSession() {
+        if (active) {
+            MetricsRegistry::shared().stopFileExporter();
+        }
+    }
+};
+
+// Parses "RATE" or "RATE:BURST"; the burst defaults to one second's worth
+bool parseRateLimit(const char* text, double& rate, double& burst) {
+    char* end = nullptr;
+    rate = strtod(text, &end);
+    if (end == text || rate < 0.0) {
+        return false;
+    }
+    burst = rate < 1.0 ? 1.0 : rate;
+    if (*end == ':') {
+        const char* burstText = end + 1;
+        burst = strtod(burstText, &end);
+        if (end == burstText || burst < 1.0) {
+            return false;
+        }
+    }
+    return *end == '\0';
+}
+
+int runGenerator(const DatasetSpec& spec) {
+    ThreadPool pool;
+    cout << "Generating " << spec.customers << " customers, " << spec.accounts << " accounts, "
+         << spec.transactions << " transactions and " << spec.loans << " loans (seed " << spec.seed
+         << ", " << pool.getThreadCount() << " threads)...\n";
+    
+    DatasetReport report = DatasetGenerator(spec).generate(pool);
+    if (!report.success) {
+        cerr << "Dataset generation failed: " << report.error << "\n";
+        return 1;
+    }
+    cout << "Wrote " << fixed << setprecision(1) << report.bytesWritten / 1048576.0 << " MB to "
+         << spec.directory << "/ in " << setprecision(2) << report.seconds << "s\n";
+    return 0;
+}
+
+int runServer(BankingSystem& bank, const string& socketPath, int port, const string& recordDirectory) {
+    BankServer server(bank);
+    bool listening = port > 0 ? server.listenTcp(port) : server.listenUnix(socketPath);
+    if (!listening) {
+        return 1;
+    }
+
+    // The snapshot is the data as loaded, so the recording replays from the same state
+    WorkloadRecorder recorder;
+    if (!recordDirectory.empty()) {
+        bank.saveData();
+        if (!recorder.open(recordDirectory, bank.getDataFiles())) {
+            cerr << "Cannot start recording: " << recorder.getError() << "\n";
+            return 1;
+        }
+        server.setRecorder(&recorder);
+        cout << "Recording requests to " << recordDirectory << "/\n";
+    }
+
+    activeServer = &server;
+    signal(SIGINT, handleShutdownSignal);
+    signal(SIGTERM, handleShutdownSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    if (port > 0) {
+        cout << "Oyanib Bank server listening on 127.0.0.1:" << port << "\n";
+    } else {
+        cout << "Oyanib Bank server listening on " << socketPath << "\n";
+    }
+    server.run();
+    activeServer = nullptr;
+
+    recorder.close();
+    cout << "Server stopped after " << server.getRequestsServed() << " requests. Saving data...\n";
+    bank.saveData();
+    return 0;
+}
+
+// Replays in a scratch copy of the recording's data so neither it nor the live files change
+int runReplay(const string& directory, uint64_t seed) {
+    WorkloadReplayer replayer(directory);
+    string error;
+    if (!replayer.load(error)) {
+        cerr << "Cannot replay: " << error << "\n";
+        return 1;
+    }
+
+    string originalDirectory = filesystem::current_path().string();
+    char scratchTemplate[] = "/tmp/oyanib_replay_XXXXXX";
+    if (!mkdtemp(scratchTemplate) || chdir(scratchTemplate) != 0) {
+        cerr << "Cannot create a scratch directory.\n";
+        return 1;
+    }
+
+    IdGenerator::shared().setSeed(seed);
+    PeriodClock::shared().setVirtualTime(replayer.getStartSeconds());
+    int status = 0;
+    {
+        BankingSystem bank;
+        if (!replayer.restoreSnapshot(bank.getDataFiles(), error)) {
+            cerr << "Cannot replay: " << error << "\n";
+            status = 1;
+        } else {
+            bank.loadData();
+            cout << "Replaying " << replayer.getOperationCount() << " requests from " << directory
+                 << "/ (seed " << seed << ")...\n";
+            ReplayReport report = replayer.replay(bank);
+            report.print(cout);
+        }
+    }
+
+    if (chdir(originalDirectory.c_str()) != 0) {
+        cerr << "Cannot return to " << originalDirectory << "\n";
+    }
+    error_code removeError;
+    filesystem::remove_all(scratchTemplate, removeError);
+    PeriodClock::shared().useWallClock();
+    IdGenerator::shared().useRandomDevice();
+    return status;
+}
+
 void clearScreen() {
     #ifdef _WIN32
         system("cls");
@@ -74,7 +273,11 @@ void showAdminMenu() {
     cout << "│ 4. Calculate Interest                         │\n";
     cout << "│ 5. System Statistics                          │\n";
     cout << "│ 6. Backup Database                            │\n";
-    cout << "│ 7. Return to Main Menu                        │\n";
+    cout << "│ 7. Run End-of-Day Batch                       │\n";
+    cout << "│ 8. Loan Portfolio Analytics                   │\n";
+    cout << "│ 9. Generate Monthly Statements                │\n";
+    cout << "│ 10. Memory Usage                              │\n";
+    cout << "│ 11. Return to Main Menu                       │\n";
     cout << "└─────────────────────────────────────────────┘\n";
     cout << "Enter your choice: ";
 }
@@ -103,11 +306,90 @@ void showAbout() {
     cin.get();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    bool serverMode = false;
+    string socketPath = "oyanib_bank.sock";
+    int port = 0;
+    double customerRate = 0.0, customerBurst = 1.0;
+    double globalRate = 0.0, globalBurst = 1.0;
+    bool generateMode = false;
+    DatasetSpec dataset;
+    string traceFile;
+    string metricsFile;
+    string recordDirectory;
+    string replayDirectory;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--server") == 0) {
+            serverMode = true;
+        } else if (strcmp(argv[i], "--generate") == 0) {
+            generateMode = true;
+        } else if (strcmp(argv[i], "--customers") == 0 && i + 1 < argc) {
+            dataset.customers = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--accounts") == 0 && i + 1 < argc) {
+            dataset.accounts = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--transactions") == 0 && i + 1 < argc) {
+            dataset.transactions = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--loans") == 0 && i + 1 < argc) {
+            dataset.loans = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            dataset.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            dataset.directory = argv[++i];
+        } else if (strcmp(argv[i], "--as-of") == 0 && i + 1 < argc) {
+            int year = 0, month = 0, day = 0;
+            if (sscanf(argv[++i], "%d-%d-%d", &year, &month, &day) != 3) {
+                showUsage(argv[0]);
+                return 1;
+            }
+            dataset.asOfDay = PeriodClock::daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordDirectory = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayDirectory = argv[++i];
+        } else if (strcmp(argv[i], "--metrics-file") == 0 && i + 1 < argc) {
+            metricsFile = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--customer-rate") == 0 && i + 1 < argc &&
+                   parseRateLimit(argv[i + 1], customerRate, customerBurst)) {
+            ++i;
+        } else if (strcmp(argv[i], "--global-rate") == 0 && i + 1 < argc &&
+                   parseRateLimit(argv[i + 1], globalRate, globalBurst)) {
+            ++i;
+        } else {
+            showUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    
+    // Generation runs before any bank exists: the bank saves its (empty) data on exit
+    if (generateMode) {
+        return runGenerator(dataset);
+    }
+    
+    TraceSession trace(traceFile);
+    if (!replayDirectory.empty()) {
+        return runReplay(replayDirectory, dataset.seed);
+    }
+    
     BankingSystem bank;
+    bank.getAdmissionController().setCustomerLimit(customerRate, customerBurst);
+    bank.getAdmissionController().setGlobalLimit(globalRate, globalBurst);
     
     // Load existing data
     bank.loadData();
+    bank.getLoadProfile().print(cout);
+    bank.startRolloverScheduler();
+    MetricsFileSession metrics(metricsFile);
+    
+    if (serverMode) {
+        return runServer(bank, socketPath, port, recordDirectory);
+    }
     
     int choice;
     bool running = true;
@@ -245,6 +527,18 @@ int main() {
                                 bank.backupDatabase();
                                 break;
                             case 7:
+                                bank.processEndOfDay();
+                                break;
+                            case 8:
+                                bank.displayLoanPortfolio();
+                                break;
+                            case 9:
+                                bank.processMonthlyStatements();
+                                break;
+                            case 10:
+                                bank.displayMemoryUsage();
+                                break;
+                            case 11:
                                 adminSession = false;
                                 break;
                             default:
@@ -0,0 +1,279 @@
+// Load generator for the Oyanib Bank server front end.
+//
+// Opens many client connections, registers a customer with two accounts on
+// each, then drives a closed-loop mix of BALANCE/DEPOSIT/WITHDRAW/TRANSFER
+// requests (one outstanding request per connection) and reports end-to-end
+// latency percentiles and throughput.
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct Options {
+    string socketPath = "oyanib_bank.sock";
+    int port = 0;
+    int connections = 100;
+    int threads = 2;
+    int requests = 1000;
+};
+
+struct ClientConnection {
+    int fd = -1;
+    string primaryAccount;
+    string secondaryAccount;
+    string readBuffer;
+    int remaining = 0;
+    Clock::time_point sentAt;
+    mt19937 rng;
+};
+
+struct ThreadResult {
+    vector<uint32_t> latenciesMicros;
+    unsigned long long errors = 0;
+};
+
+int connectToServer(const Options& options) {
+    int fd;
+    if (options.port > 0) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<uint16_t>(options.port));
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            if (fd >= 0) close(fd);
+            return -1;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    } else {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, options.socketPath.c_str(), sizeof(addr.sun_path) - 1);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            if (fd >= 0) close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+bool sendLine(int fd, const string& line) {
+    string data = line + "\n";
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                this_thread::yield();
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Blocking request used only during the setup phase
+string request(ClientConnection& client, const string& line) {
+    if (!sendLine(client.fd, line)) return "";
+    char buffer[4096];
+    while (client.readBuffer.find('\n') == string::npos) {
+        ssize_t n = read(client.fd, buffer, sizeof(buffer));
+        if (n <= 0) return "";
+        client.readBuffer.append(buffer, static_cast<size_t>(n));
+    }
+    size_t newline = client.readBuffer.find('\n');
+    string response = client.readBuffer.substr(0, newline);
+    client.readBuffer.erase(0, newline + 1);
+    return response;
+}
+
+string field(const string& response, int index) {
+    istringstream iss(response);
+    string token;
+    for (int i = 0; i <= index; ++i) {
+        if (!(iss >> token)) return "";
+    }
+    return token;
+}
+
+bool setupClient(ClientConnection& client, int id) {
+    string registered = request(client, "REGISTER loadgen" + to_string(id) + " lg" + to_string(id) + "@example.com pw" + to_string(id));
+    if (field(registered, 0) != "OK") return false;
+    if (field(request(client, "LOGIN " + field(registered, 1) + " pw" + to_string(id)), 0) != "OK") return false;
+
+    string primary = request(client, "OPEN Checking 100000");
+    string secondary = request(client, "OPEN Checking 1000");
+    if (field(primary, 0) != "OK" || field(secondary, 0) != "OK") return false;
+    client.primaryAccount = field(primary, 1);
+    client.secondaryAccount = field(secondary, 1);
+    return true;
+}
+
+string nextRequest(ClientConnection& client) {
+    uniform_int_distribution<int> pick(0, 99);
+    int roll = pick(client.rng);
+    if (roll < 40) return "DEPOSIT " + client.primaryAccount + " 10";
+    if (roll < 60) return "WITHDRAW " + client.primaryAccount + " 1";
+    if (roll < 80) return "TRANSFER " + client.primaryAccount + " " + client.secondaryAccount + " 1";
+    return "BALANCE " + client.primaryAccount;
+}
+
+void runWorker(vector<ClientConnection*> clients, ThreadResult& result) {
+    int epollFd = epoll_create1(0);
+    for (auto* client : clients) {
+        fcntl(client->fd, F_SETFL, fcntl(client->fd, F_GETFL, 0) | O_NONBLOCK);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = client;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, client->fd, &event);
+
+        client->sentAt = Clock::now();
+        sendLine(client->fd, nextRequest(*client));
+    }
+
+    size_t active = clients.size();
+    vector<epoll_event> events(256);
+    char buffer[16384];
+
+    while (active > 0) {
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 1000);
+        if (ready < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < ready; ++i) {
+            auto* client = static_cast<ClientConnection*>(events[i].data.ptr);
+            ssize_t n;
+            while ((n = read(client->fd, buffer, sizeof(buffer))) > 0) {
+                client->readBuffer.append(buffer, static_cast<size_t>(n));
+            }
+            if (n == 0) {
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, client->fd, nullptr);
+                active--;
+                continue;
+            }
+
+            size_t newline;
+            while ((newline = client->readBuffer.find('\n')) != string::npos) {
+                auto now = Clock::now();
+                result.latenciesMicros.push_back(static_cast<uint32_t>(
+                    chrono::duration_cast<chrono::microseconds>(now - client->sentAt).count()));
+                if (client->readBuffer.compare(0, 3, "ERR") == 0) {
+                    result.errors++;
+                }
+                client->readBuffer.erase(0, newline + 1);
+
+                if (--client->remaining > 0) {
+                    client->sentAt = Clock::now();
+                    sendLine(client->fd, nextRequest(*client));
+                } else {
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, client->fd, nullptr);
+                    active--;
+                }
+            }
+        }
+    }
+    close(epollFd);
+}
+
+uint32_t percentile(const vector<uint32_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) options.socketPath = argv[++i];
+        else if (arg == "--port" && i + 1 < argc) options.port = atoi(argv[++i]);
+        else if (arg == "--connections" && i + 1 < argc) options.connections = atoi(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) options.threads = atoi(argv[++i]);
+        else if (arg == "--requests" && i + 1 < argc) options.requests = atoi(argv[++i]);
+        else {
+            cout << "Usage: " << argv[0] << " [--socket PATH | --port N] [--connections C]"
+                 << " [--threads T] [--requests R]\n";
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    options.threads = max(1, min(options.threads, options.connections));
+
+    vector<ClientConnection> clients(static_cast<size_t>(options.connections));
+    for (int i = 0; i < options.connections; ++i) {
+        auto& client = clients[static_cast<size_t>(i)];
+        client.fd = connectToServer(options);
+        if (client.fd < 0) {
+            cerr << "Connection " << i << " failed: " << strerror(errno)
+                 << " (check the server is running and the open file limit)\n";
+            return 1;
+        }
+        if (!setupClient(client, i)) {
+            cerr << "Setup failed on connection " << i << "\n";
+            return 1;
+        }
+        client.remaining = options.requests;
+        client.rng.seed(static_cast<unsigned>(i));
+    }
+    cout << "Connected and set up " << options.connections << " clients.\n";
+
+    vector<ThreadResult> results(static_cast<size_t>(options.threads));
+    vector<thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < options.threads; ++t) {
+        vector<ClientConnection*> share;
+        for (size_t i = static_cast<size_t>(t); i < clients.size(); i += static_cast<size_t>(options.threads)) {
+            share.push_back(&clients[i]);
+        }
+        workers.emplace_back(runWorker, share, ref(results[static_cast<size_t>(t)]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<uint32_t> latencies;
+    unsigned long long errors = 0;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latenciesMicros.begin(), result.latenciesMicros.end());
+        errors += result.errors;
+    }
+    sort(latencies.begin(), latencies.end());
+
+    for (auto& client : clients) {
+        close(client.fd);
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "Requests:    " << latencies.size() << " (" << errors << " ERR responses)\n";
+    cout << "Elapsed:     " << seconds << " s\n";
+    cout << "Throughput:  " << (seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0.0) << " req/s\n";
+    cout << "Latency us:  p50=" << percentile(latencies, 50) << " p99=" << percentile(latencies, 99)
+         << " p99.9=" << percentile(latencies, 99.9)
+         << " max=" << (latencies.empty() ? 0 : latencies.back()) << "\n";
+    return 0;
+}